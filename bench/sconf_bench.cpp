@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <sconf.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sconf_generator.hpp"
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static std::atomic<std::uint64_t> allocationCount{0};
+static std::atomic<std::uint64_t> allocationBytes{0};
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if(void* pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+using Clock = std::chrono::steady_clock;
+
+struct AllocationScope {
+    std::uint64_t count = allocationCount.load();
+    std::uint64_t bytes = allocationBytes.load();
+
+    std::uint64_t allocations() const {
+        return allocationCount.load() - this->count;
+    }
+
+    std::uint64_t allocatedBytes() const {
+        return allocationBytes.load() - this->bytes;
+    }
+};
+
+struct BenchOptions {
+    std::vector<std::uint64_t> sizes = {1 << 10, 1 << 20, 16 << 20};
+    std::uint64_t lookupSize = 1 << 20;
+    std::vector<unsigned> threads = {1, 2, 4, 8, 16, 32, 64};
+    std::uint64_t operations = 200000;
+    std::string directory = ".";
+    std::string filter;
+    sConfGeneratorOptions generator;
+};
+
+static double seconds(Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+static bool selected(const BenchOptions& options, const std::string& name) {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+static std::string fileFor(const BenchOptions& options, std::uint64_t size) {
+    return options.directory + "/sconf_bench_" + std::to_string(size) + ".sconf";
+}
+
+static void reportLatency(
+    const std::string& name,
+    std::vector<std::uint64_t>& samples,
+    const AllocationScope& allocations
+) {
+    std::sort(samples.begin(), samples.end());
+
+    auto percentile = [&samples](double fraction) {
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+        return samples[index];
+    };
+
+    std::uint64_t total = 0;
+    for(std::uint64_t sample : samples)
+        total += sample;
+
+    double count = static_cast<double>(samples.size());
+    std::printf(
+        "{\"benchmark\":\"%s\",\"ops\":%zu,\"mean_ns\":%.1f,\"p50_ns\":%llu,"
+        "\"p90_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu,"
+        "\"ops_per_s\":%.0f,\"allocations_per_op\":%.3f,\"allocated_bytes_per_op\":%.1f}\n",
+        name.c_str(),
+        samples.size(),
+        static_cast<double>(total) / count,
+        static_cast<unsigned long long>(percentile(0.50)),
+        static_cast<unsigned long long>(percentile(0.90)),
+        static_cast<unsigned long long>(percentile(0.99)),
+        static_cast<unsigned long long>(percentile(0.999)),
+        static_cast<unsigned long long>(samples.back()),
+        count / (static_cast<double>(total) * 1e-9),
+        static_cast<double>(allocations.allocations()) / count,
+        static_cast<double>(allocations.allocatedBytes()) / count
+    );
+}
+
+static void measure(
+    const std::string& name,
+    std::uint64_t operations,
+    const std::function<void(std::uint64_t)>& operation
+) {
+    std::vector<std::uint64_t> samples;
+    samples.reserve(operations);
+
+    for(std::uint64_t i = 0; i < std::min<std::uint64_t>(operations / 10, 1000); ++i)
+        operation(i);
+
+    AllocationScope allocations;
+    for(std::uint64_t i = 0; i < operations; ++i) {
+        Clock::time_point start = Clock::now();
+        operation(i);
+
+        samples.push_back(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()
+        ));
+    }
+
+    reportLatency(name, samples, allocations);
+}
+
+static void benchLoadSave(const BenchOptions& options) {
+    for(std::uint64_t size : options.sizes) {
+        sConfGeneratorOptions generatorOptions = options.generator;
+        generatorOptions.targetBytes = size;
+
+        sConfGenerator generator(generatorOptions);
+        std::string filename = fileFor(options, size);
+        std::uint64_t bytes = generator.generateFile(filename);
+        double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+        double keys = static_cast<double>(generator.getKeyCount());
+
+        sConfParser parser;
+        if(selected(options, "load")) {
+            AllocationScope allocations;
+            Clock::time_point start = Clock::now();
+            parser.load(filename);
+            double elapsed = seconds(Clock::now() - start);
+
+            std::printf(
+                "{\"benchmark\":\"load\",\"bytes\":%llu,\"sections\":%llu,\"keys\":%llu,"
+                "\"seconds\":%.6f,\"mb_per_s\":%.2f,\"keys_per_s\":%.0f,"
+                "\"allocations\":%llu,\"allocated_bytes\":%llu}\n",
+                static_cast<unsigned long long>(bytes),
+                static_cast<unsigned long long>(generator.getSectionCount()),
+                static_cast<unsigned long long>(generator.getKeyCount()),
+                elapsed,
+                megabytes / elapsed,
+                keys / elapsed,
+                static_cast<unsigned long long>(allocations.allocations()),
+                static_cast<unsigned long long>(allocations.allocatedBytes())
+            );
+        }
+        else parser.load(filename);
+
+        if(selected(options, "save")) {
+            std::string output = filename + ".out";
+
+            AllocationScope allocations;
+            Clock::time_point start = Clock::now();
+            parser.save(output);
+            double elapsed = seconds(Clock::now() - start);
+
+            std::printf(
+                "{\"benchmark\":\"save\",\"bytes\":%llu,\"keys\":%llu,\"seconds\":%.6f,"
+                "\"mb_per_s\":%.2f,\"keys_per_s\":%.0f,\"allocations\":%llu,\"allocated_bytes\":%llu}\n",
+                static_cast<unsigned long long>(bytes),
+                static_cast<unsigned long long>(generator.getKeyCount()),
+                elapsed,
+                megabytes / elapsed,
+                keys / elapsed,
+                static_cast<unsigned long long>(allocations.allocations()),
+                static_cast<unsigned long long>(allocations.allocatedBytes())
+            );
+
+            std::remove(output.c_str());
+        }
+
+        std::remove(filename.c_str());
+    }
+}
+
+struct LookupSet {
+    std::vector<std::string> sections;
+    std::vector<std::string> keys;
+};
+
+static LookupSet lookupSet(
+    const sConfParser& parser,
+    std::size_t keysPerSection,
+    std::uint64_t count
+) {
+    LookupSet set;
+    std::vector<std::string> sections = parser.getSections();
+    std::sort(sections.begin(), sections.end());
+
+    std::uint64_t state = 42;
+    for(std::uint64_t i = 0; i < count; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        set.sections.push_back(sections[(state >> 33) % sections.size()]);
+        set.keys.push_back(i % 10 == 9 ?
+            "missing_key" :
+            "key_" + std::to_string((state >> 17) % std::max<std::size_t>(keysPerSection, 1))
+        );
+    }
+
+    return set;
+}
+
+static void benchLookups(const BenchOptions& options) {
+    sConfGeneratorOptions generatorOptions = options.generator;
+    generatorOptions.targetBytes = options.lookupSize;
+
+    sConfGenerator generator(generatorOptions);
+    std::string filename = fileFor(options, options.lookupSize);
+    generator.generateFile(filename);
+
+    sConfParser parser;
+    parser.load(filename);
+    std::remove(filename.c_str());
+
+    const std::uint64_t operations = options.operations;
+    LookupSet set = lookupSet(parser, generatorOptions.keysPerSection, 4096);
+    auto at = [&set](std::uint64_t i) {
+        return i % set.sections.size();
+    };
+
+    if(selected(options, "getSection"))
+        measure("getSection", operations / 10, [&](std::uint64_t i) {
+            auto section = parser.getSection(set.sections[at(i)]);
+            (void) section;
+        });
+
+    if(selected(options, "hasSectionPairByKey")) {
+        volatile bool sink = false;
+        measure("hasSectionPairByKey", operations, [&](std::uint64_t i) {
+            sink = parser.hasSectionPairByKey(set.sections[at(i)], set.keys[at(i)]);
+        });
+        (void) sink;
+    }
+
+    if(selected(options, "setKey")) {
+        sConfValue value(std::string("benchmark"));
+        measure("setKey", operations, [&](std::uint64_t i) {
+            parser.setKey(set.sections[at(i)], set.keys[at(i)], value);
+        });
+    }
+
+    if(selected(options, "getters")) {
+        std::tm date{};
+        date.tm_year = 124;
+        date.tm_mon = 5;
+        date.tm_mday = 15;
+
+        sConfValue stringValue(std::string("benchmark value")),
+            integerValue(123456),
+            doubleValue(3.14159),
+            booleanValue(true),
+            dateValue(date),
+            arrayValue(std::vector<sConfValue>{integerValue, doubleValue, stringValue, booleanValue});
+
+        volatile std::size_t sink = 0;
+        measure("getString", operations, [&](std::uint64_t) {
+            sink = stringValue.getString().size();
+        });
+        measure("getInteger", operations, [&](std::uint64_t) {
+            sink = static_cast<std::size_t>(integerValue.getInteger());
+        });
+        measure("getDouble", operations, [&](std::uint64_t) {
+            sink = static_cast<std::size_t>(doubleValue.getDouble());
+        });
+        measure("getBoolean", operations, [&](std::uint64_t) {
+            sink = booleanValue.getBoolean();
+        });
+        measure("getDate", operations, [&](std::uint64_t) {
+            sink = static_cast<std::size_t>(dateValue.getDate().tm_mday);
+        });
+        measure("getArray", operations, [&](std::uint64_t) {
+            sink = arrayValue.getArray().size();
+        });
+        (void) sink;
+    }
+
+    if(selected(options, "concurrent_lookup")) {
+        sConfConcurrent concurrent(parser);
+        double baseline = 0.0;
+
+        for(unsigned threadCount : options.threads) {
+            std::atomic<bool> go{false}, stop{false};
+            std::atomic<std::uint64_t> total{0}, sink{0};
+            std::vector<std::thread> workers;
+
+            for(unsigned t = 0; t < threadCount; ++t)
+                workers.emplace_back([&, t]() {
+                    sConfConcurrent::Reader reader(concurrent);
+                    std::uint64_t count = 0, hits = 0, i = t * 977;
+
+                    while(!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+
+                    while(!stop.load(std::memory_order_relaxed)) {
+                        std::size_t index = at(i++);
+
+                        hits += reader->hasSectionPairByKey(set.sections[index], set.keys[index]);
+                        count++;
+                    }
+
+                    total.fetch_add(count);
+                    sink.fetch_add(hits, std::memory_order_relaxed);
+                });
+
+            Clock::time_point start = Clock::now();
+            go.store(true, std::memory_order_release);
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            stop.store(true);
+
+            for(auto& worker : workers)
+                worker.join();
+
+            double opsPerSecond = static_cast<double>(total.load()) / seconds(Clock::now() - start);
+            if(baseline == 0.0)
+                baseline = opsPerSecond / threadCount;
+
+            std::printf(
+                "{\"benchmark\":\"concurrent_lookup\",\"threads\":%u,\"ops_per_s\":%.0f,"
+                "\"speedup\":%.2f}\n",
+                threadCount,
+                opsPerSecond,
+                opsPerSecond / baseline
+            );
+        }
+    }
+}
+
+template<typename T, typename Parse>
+static std::vector<T> parseList(const std::string& text, Parse parse) {
+    std::vector<T> values;
+    std::istringstream stream(text);
+    std::string item;
+
+    while(std::getline(stream, item, ','))
+        values.push_back(static_cast<T>(parse(item)));
+    return values;
+}
+
+static void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+        << "  --sizes <list>           document sizes for load/save (default 1K,1M,16M)\n"
+        << "  --lookup-size <n>        document size for lookup benchmarks (default 1M)\n"
+        << "  --threads <list>         thread counts for concurrent_lookup\n"
+        << "  --ops <n>                operations per micro benchmark (default 200000)\n"
+        << "  --keys-per-section <n>   keys in each generated section (default 16)\n"
+        << "  --array-width <n>        elements per generated array (default 4)\n"
+        << "  --array-ratio <r>        fraction of array values (default 0.1)\n"
+        << "  --comment-density <r>    probability of comments (default 0.1)\n"
+        << "  --seed <n>               generator seed\n"
+        << "  --dir <path>             scratch directory for generated files\n"
+        << "  --filter <name>          only run benchmarks whose name contains this\n";
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+
+    try {
+        for(int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            if(i + 1 >= argc) {
+                usage(argv[0]);
+                return 1;
+            }
+
+            std::string value = argv[++i];
+            if(argument == "--sizes")
+                options.sizes = parseList<std::uint64_t>(value, sConfGenerator::parseSize);
+            else if(argument == "--lookup-size")
+                options.lookupSize = sConfGenerator::parseSize(value);
+            else if(argument == "--threads")
+                options.threads = parseList<unsigned>(value, [](const std::string& item) {
+                    return std::stoul(item);
+                });
+            else if(argument == "--ops")
+                options.operations = std::stoull(value);
+            else if(argument == "--keys-per-section")
+                options.generator.keysPerSection = std::stoul(value);
+            else if(argument == "--array-width")
+                options.generator.arrayWidth = std::stoul(value);
+            else if(argument == "--array-ratio")
+                options.generator.arrayRatio = std::stod(value);
+            else if(argument == "--comment-density")
+                options.generator.commentDensity = std::stod(value);
+            else if(argument == "--seed")
+                options.generator.seed = std::stoull(value);
+            else if(argument == "--dir")
+                options.directory = value;
+            else if(argument == "--filter")
+                options.filter = value;
+            else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+
+        benchLoadSave(options);
+        benchLookups(options);
+    }
+    catch(const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "sconf_generator.hpp"
+
+static void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] <output.sconf>\n"
+        << "  --size <n[K|M|G]>        approximate document size (default 1M)\n"
+        << "  --keys-per-section <n>   keys in each section (default 16)\n"
+        << "  --array-width <n>        elements per array value (default 4)\n"
+        << "  --array-ratio <r>        fraction of array values (default 0.1)\n"
+        << "  --comment-density <r>    probability of comments (default 0.1)\n"
+        << "  --seed <n>               pseudo-random seed\n";
+}
+
+int main(int argc, char** argv) {
+    sConfGeneratorOptions options;
+    std::string output;
+
+    try {
+        for(int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if(argument == "--size" && hasValue)
+                options.targetBytes = sConfGenerator::parseSize(argv[++i]);
+            else if(argument == "--keys-per-section" && hasValue)
+                options.keysPerSection = std::stoul(argv[++i]);
+            else if(argument == "--array-width" && hasValue)
+                options.arrayWidth = std::stoul(argv[++i]);
+            else if(argument == "--array-ratio" && hasValue)
+                options.arrayRatio = std::stod(argv[++i]);
+            else if(argument == "--comment-density" && hasValue)
+                options.commentDensity = std::stod(argv[++i]);
+            else if(argument == "--seed" && hasValue)
+                options.seed = std::stoull(argv[++i]);
+            else if(argument.rfind("--", 0) == 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            else output = argument;
+        }
+
+        if(output.empty()) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        sConfGenerator generator(options);
+        std::uint64_t bytes = generator.generateFile(output);
+
+        std::cout << "{\"file\":\"" << output << "\",\"bytes\":" << bytes
+            << ",\"sections\":" << generator.getSectionCount()
+            << ",\"keys\":" << generator.getKeyCount() << "}\n";
+    }
+    catch(const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
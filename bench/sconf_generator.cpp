@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sconf_exception.hpp>
+
+#include "sconf_generator.hpp"
+
+std::uint64_t sConfGenerator::next() {
+    std::uint64_t value = (this->state += 0x9E3779B97F4A7C15ULL);
+
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+double sConfGenerator::uniform() {
+    return static_cast<double>(this->next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+std::string sConfGenerator::scalar() {
+    static const char* const words[] = {
+        "alpha", "bravo", "charlie", "delta", "echo",
+        "foxtrot", "golf", "hotel", "india", "juliet"
+    };
+
+    char buffer[64];
+    switch(this->next() % 6) {
+        case 0:
+            return std::to_string(static_cast<std::int64_t>(this->next() % 2000000) - 1000000);
+
+        case 1:
+            std::snprintf(buffer, sizeof(buffer), "%.4f", this->uniform() * 1000.0);
+            return buffer;
+
+        case 2:
+            return (this->next() & 1) ? "true" : "false";
+
+        case 3:
+            std::snprintf(
+                buffer,
+                sizeof(buffer),
+                "%04d-%02d-%02d %02d:%02d:%02d",
+                static_cast<int>(2000 + this->next() % 30),
+                static_cast<int>(1 + this->next() % 12),
+                static_cast<int>(1 + this->next() % 28),
+                static_cast<int>(this->next() % 24),
+                static_cast<int>(this->next() % 60),
+                static_cast<int>(this->next() % 60)
+            );
+            return buffer;
+
+        case 4:
+            return std::string("\"") + words[this->next() % 10] + " " + words[this->next() % 10] + "\"";
+
+        default:
+            return std::string(words[this->next() % 10]) + "_" + std::to_string(this->next() % 100000);
+    }
+}
+
+std::uint64_t sConfGenerator::generate(std::ostream& out) {
+    this->state = this->options.seed;
+    this->sections = 0;
+    this->keys = 0;
+
+    std::uint64_t written = 0;
+    std::string line;
+
+    auto emit = [&](const std::string& text) {
+        out << text << '\n';
+        written += text.size() + 1;
+    };
+
+    while(written < this->options.targetBytes) {
+        if(this->uniform() < this->options.commentDensity)
+            emit("; Section " + std::to_string(this->sections) + " generated for benchmarking");
+        emit("[section_" + std::to_string(this->sections) + "]");
+
+        for(size_t i = 0; i < this->options.keysPerSection && written < this->options.targetBytes; ++i) {
+            if(this->uniform() < this->options.commentDensity)
+                emit("; Describes key_" + std::to_string(i));
+
+            line = "key_" + std::to_string(i) + " = ";
+            if(this->uniform() < this->options.arrayRatio) {
+                line += "[";
+                for(size_t j = 0; j < this->options.arrayWidth; ++j) {
+                    if(j > 0)
+                        line += ", ";
+                    line += this->scalar();
+                }
+                line += "]";
+            }
+            else line += this->scalar();
+
+            if(this->uniform() < this->options.commentDensity)
+                line += " ; inline note";
+
+            emit(line);
+            this->keys++;
+        }
+
+        emit("");
+        this->sections++;
+    }
+
+    return written;
+}
+
+std::uint64_t sConfGenerator::generateFile(const std::string& filename) {
+    std::ofstream file(filename, std::ios::binary);
+    if(!file)
+        throw SconfException("Failed to open file for writing: " + filename);
+
+    return this->generate(file);
+}
+
+std::uint64_t sConfGenerator::getSectionCount() const {
+    return this->sections;
+}
+
+std::uint64_t sConfGenerator::getKeyCount() const {
+    return this->keys;
+}
+
+std::uint64_t sConfGenerator::parseSize(const std::string& text) {
+    std::size_t position = 0;
+    std::uint64_t value = std::stoull(text, &position);
+
+    if(position < text.size())
+        switch(text[position]) {
+            case 'k': case 'K': return value << 10;
+            case 'm': case 'M': return value << 20;
+            case 'g': case 'G': return value << 30;
+            default:
+                throw SconfException("Invalid size: " + text);
+        }
+
+    return value;
+}
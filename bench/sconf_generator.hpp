@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_generator.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Deterministic generator of synthetic sConf documents for benchmarks.
+ */
+#ifndef SCONF_GENERATOR_HPP
+#define SCONF_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @struct sConfGeneratorOptions
+ * @brief Shape of the generated document.
+ */
+struct sConfGeneratorOptions {
+    /**
+     * @brief Approximate size of the document in bytes.
+     */
+    std::uint64_t targetBytes = 1024 * 1024;
+
+    /**
+     * @brief Number of key-value pairs per section.
+     */
+    std::size_t keysPerSection = 16;
+
+    /**
+     * @brief Number of elements in generated array values.
+     */
+    std::size_t arrayWidth = 4;
+
+    /**
+     * @brief Fraction of values that are arrays, between 0 and 1.
+     */
+    double arrayRatio = 0.1;
+
+    /**
+     * @brief Probability of a comment line before a section or key, and
+     *        of an inline comment after a value, between 0 and 1.
+     */
+    double commentDensity = 0.1;
+
+    /**
+     * @brief Seed of the pseudo-random sequence.
+     */
+    std::uint64_t seed = 0x5C0F;
+};
+
+/**
+ * @class sConfGenerator
+ * @brief Writes synthetic sConf documents.
+ *
+ * The output depends only on the options: the generator uses its own
+ * pseudo-random sequence instead of the standard distributions, whose
+ * results differ between standard library implementations.
+ */
+class sConfGenerator {
+public:
+    /**
+     * @brief Constructs a generator.
+     * @param options The shape of the documents to generate.
+     */
+    explicit sConfGenerator(const sConfGeneratorOptions& options) :
+        options(options),
+        state(options.seed),
+        sections(0),
+        keys(0) {}
+
+    /**
+     * @brief Writes a document to a stream.
+     * @param out The stream to write to.
+     * @return The number of bytes written.
+     */
+    std::uint64_t generate(std::ostream& out);
+
+    /**
+     * @brief Writes a document to a file.
+     * @param filename The path of the file to write.
+     * @return The number of bytes written.
+     */
+    std::uint64_t generateFile(const std::string& filename);
+
+    /**
+     * @brief Retrieves the number of sections written by the last run.
+     * @return The section count.
+     */
+    std::uint64_t getSectionCount() const;
+
+    /**
+     * @brief Retrieves the number of keys written by the last run.
+     * @return The key count.
+     */
+    std::uint64_t getKeyCount() const;
+
+    /**
+     * @brief Parses a size such as `512`, `64K`, `16M` or `1G`.
+     * @param text The size text, with an optional binary unit suffix.
+     * @return The size in bytes.
+     */
+    static std::uint64_t parseSize(const std::string& text);
+
+private:
+    /**
+     * @brief Advances the pseudo-random sequence (SplitMix64).
+     * @return The next pseudo-random number.
+     */
+    std::uint64_t next();
+
+    /**
+     * @brief Draws a pseudo-random number in [0, 1).
+     * @return The number.
+     */
+    double uniform();
+
+    /**
+     * @brief Produces a random scalar value of a random type.
+     * @return The value text.
+     */
+    std::string scalar();
+
+    /**
+     * @brief The shape of the documents to generate.
+     */
+    sConfGeneratorOptions options;
+
+    /**
+     * @brief State of the pseudo-random sequence.
+     */
+    std::uint64_t state;
+
+    /**
+     * @brief Number of sections written by the last run.
+     */
+    std::uint64_t sections;
+
+    /**
+     * @brief Number of keys written by the last run.
+     */
+    std::uint64_t keys;
+};
+
+#endif
@@ -30,7 +30,22 @@
 #define SCONF_HPP
 
 #include <sconf_exception.hpp>
+#include <sconf_result.hpp>
 #include <sconf_value.hpp>
+#include <sconf_diagnostic.hpp>
+#include <sconf_diff.hpp>
+#include <sconf_events.hpp>
+#include <sconf_interpolation.hpp>
+#include <sconf_location.hpp>
+#include <sconf_memory.hpp>
+#include <sconf_options.hpp>
+#include <sconf_stats.hpp>
+#include <sconf_subscriptions.hpp>
 #include <sconf_parser.hpp>
+#include <sconf_concurrent.hpp>
+#include <sconf_layered.hpp>
+#include <sconf_binding.hpp>
+#include <sconf_schema.hpp>
+#include <sconf_watcher.hpp>
 
 #endif
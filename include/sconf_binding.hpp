@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_binding.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for binding sConfParser sections to plain structs
+ *        through compile-time field tables.
+ */
+#ifndef SCONF_BINDING_HPP
+#define SCONF_BINDING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <sconf_exception.hpp>
+#include <sconf_parser.hpp>
+#include <sconf_value.hpp>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct sConfFieldTraits
+ * @brief Converts between sConfValue and the type of a bound field.
+ *
+ * Specialized for `int`, `std::int64_t`, `std::uint64_t`, `float`,
+ * `double`, `bool`, `std::string`, `std::tm`, `sConfValue::TimePoint`,
+ * `std::chrono::nanoseconds`, `sConfValue` and `std::vector` of any of
+ * these. Specialize it with the same two static functions to bind fields
+ * of other types.
+ *
+ * @tparam T The field type.
+ */
+template<typename T>
+struct sConfFieldTraits;
+
+/**
+ * @struct sConfScalarFieldTraits
+ * @brief Field conversion for the types sConfValue::tryAs() reads
+ *        without throwing.
+ * @tparam T The field type.
+ */
+template<typename T>
+struct sConfScalarFieldTraits {
+    /**
+     * @brief Stores a value into a field.
+     * @param value The configuration value.
+     * @param field The field to assign.
+     * @return `true` on success, `false` if the value has another type.
+     */
+    static bool read(const sConfValue& value, T& field) noexcept {
+        sConfResult<T> result = value.tryAs<T>();
+        if(!result)
+            return false;
+
+        field = *result;
+        return true;
+    }
+
+    /**
+     * @brief Converts a field into a value.
+     * @param field The field.
+     * @return The configuration value.
+     */
+    static sConfValue write(const T& field) {
+        return sConfValue(field);
+    }
+};
+
+template<> struct sConfFieldTraits<int> : sConfScalarFieldTraits<int> {};
+template<> struct sConfFieldTraits<std::int64_t> : sConfScalarFieldTraits<std::int64_t> {};
+template<> struct sConfFieldTraits<std::uint64_t> : sConfScalarFieldTraits<std::uint64_t> {};
+template<> struct sConfFieldTraits<double> : sConfScalarFieldTraits<double> {};
+template<> struct sConfFieldTraits<bool> : sConfScalarFieldTraits<bool> {};
+template<> struct sConfFieldTraits<std::tm> : sConfScalarFieldTraits<std::tm> {};
+template<> struct sConfFieldTraits<sConfValue::TimePoint> : sConfScalarFieldTraits<sConfValue::TimePoint> {};
+template<> struct sConfFieldTraits<std::chrono::nanoseconds> : sConfScalarFieldTraits<std::chrono::nanoseconds> {};
+
+/**
+ * @brief Field conversion for raw values, copied as they are; the copy
+ *        may throw `std::bad_alloc` for strings and arrays.
+ */
+template<>
+struct sConfFieldTraits<sConfValue> {
+    static bool read(const sConfValue& value, sConfValue& field) {
+        field = value;
+        return true;
+    }
+
+    static sConfValue write(const sConfValue& field) {
+        return field;
+    }
+};
+
+/**
+ * @brief Field conversion for `float`, stored as a double.
+ */
+template<>
+struct sConfFieldTraits<float> {
+    static bool read(const sConfValue& value, float& field) noexcept {
+        sConfResult<double> result = value.tryAs<double>();
+        if(!result)
+            return false;
+
+        field = static_cast<float>(*result);
+        return true;
+    }
+
+    static sConfValue write(const float& field) {
+        return sConfValue(static_cast<double>(field));
+    }
+};
+
+/**
+ * @brief Field conversion for strings, which take the text of any scalar,
+ *        so that e.g. `version = 1.2` binds to a string field.
+ */
+template<>
+struct sConfFieldTraits<std::string> {
+    static bool read(const sConfValue& value, std::string& field) {
+        if(value.isArray())
+            return false;
+
+        field = value.toString();
+        return true;
+    }
+
+    static sConfValue write(const std::string& field) {
+        return sConfValue(field);
+    }
+};
+
+/**
+ * @brief Field conversion for vectors, stored as arrays whose elements
+ *        convert one by one.
+ * @tparam T The element type.
+ */
+template<typename T>
+struct sConfFieldTraits<std::vector<T>> {
+    static bool read(const sConfValue& value, std::vector<T>& field) {
+        sConfResult<std::vector<sConfValue>> result = value.tryAs<std::vector<sConfValue>>();
+        if(!result)
+            return false;
+
+        std::vector<T> elements(result->size());
+        for(std::size_t i = 0; i < elements.size(); ++i)
+            if(!sConfFieldTraits<T>::read((*result)[i], elements[i]))
+                return false;
+
+        field = std::move(elements);
+        return true;
+    }
+
+    static sConfValue write(const std::vector<T>& field) {
+        std::vector<sConfValue> elements;
+        elements.reserve(field.size());
+
+        for(const T& element : field)
+            elements.push_back(sConfFieldTraits<T>::write(element));
+        return sConfValue(elements);
+    }
+};
+
+/**
+ * @struct sConfMemberTraits
+ * @brief Splits a pointer to data member into its class and member type.
+ * @tparam Pointer The pointer-to-member type.
+ */
+template<typename Pointer>
+struct sConfMemberTraits;
+
+template<typename S, typename T>
+struct sConfMemberTraits<T S::*> {
+    using Struct = S;
+    using Type = T;
+};
+
+/**
+ * @struct sConfField
+ * @brief Binds one data member to a key.
+ *
+ * The member is a template argument, so its loader and saver are plain
+ * functions generated at compile time.
+ *
+ * @tparam Member A pointer to the bound data member.
+ */
+template<auto Member>
+struct sConfField {
+    using Struct = typename sConfMemberTraits<decltype(Member)>::Struct;
+    using Type = typename sConfMemberTraits<decltype(Member)>::Type;
+
+    /**
+     * @brief The key the member is stored under.
+     */
+    std::string_view key;
+
+    /**
+     * @brief Stores a value into the member.
+     * @param value The configuration value.
+     * @param object The object holding the member.
+     * @return `true` on success, `false` if the value has another type.
+     * @throws std::bad_alloc If copying the value into the member fails.
+     */
+    static bool read(const sConfValue& value, Struct& object) {
+        return sConfFieldTraits<Type>::read(value, object.*Member);
+    }
+
+    /**
+     * @brief Converts the member into a value.
+     * @param object The object holding the member.
+     * @return The configuration value.
+     */
+    static sConfValue write(const Struct& object) {
+        return sConfFieldTraits<Type>::write(object.*Member);
+    }
+};
+
+/**
+ * @struct sConfBinding
+ * @brief Describes how a struct maps to a section.
+ *
+ * Specialize it, usually through SCONF_BIND(), with a `section` name and
+ * a tuple of sConfField `fields`:
+ *
+ * @code
+ * template<>
+ * struct sConfBinding<Server> {
+ *     static constexpr const char* section = "server";
+ *     static constexpr auto fields = std::make_tuple(
+ *         sConfField<&Server::host>{"host"},
+ *         sConfField<&Server::port>{"listen-port"}
+ *     );
+ * };
+ * @endcode
+ *
+ * @tparam T The bound struct.
+ */
+template<typename T>
+struct sConfBinding;
+
+/**
+ * @struct sConfFieldTable
+ * @brief The fields of a binding, sorted by key at compile time.
+ * @tparam T The bound struct.
+ */
+template<typename T>
+struct sConfFieldTable {
+    /**
+     * @brief A field's key and its generated conversion functions.
+     */
+    struct Entry {
+        std::string_view key;
+        bool (*read)(const sConfValue&, T&);
+        sConfValue (*write)(const T&);
+    };
+
+    using Fields = std::decay_t<decltype(sConfBinding<T>::fields)>;
+
+    /**
+     * @brief Builds the table of fields, sorted by key.
+     * @return The sorted table.
+     */
+    template<std::size_t... I>
+    static constexpr std::array<Entry, sizeof...(I)> build(std::index_sequence<I...>) {
+        std::array<Entry, sizeof...(I)> sorted = {{
+            {
+                std::get<I>(sConfBinding<T>::fields).key,
+                &std::tuple_element_t<I, Fields>::read,
+                &std::tuple_element_t<I, Fields>::write
+            }...
+        }};
+
+        for(std::size_t i = 1; i < sorted.size(); ++i)
+            for(std::size_t j = i; j > 0 && sorted[j].key < sorted[j - 1].key; --j) {
+                Entry swapped = sorted[j];
+                sorted[j] = sorted[j - 1];
+                sorted[j - 1] = swapped;
+            }
+
+        return sorted;
+    }
+
+    /**
+     * @brief Checks that no two fields share a key.
+     * @param sorted The sorted table.
+     * @return `true` if all keys are distinct.
+     */
+    template<std::size_t N>
+    static constexpr bool unique(const std::array<Entry, N>& sorted) {
+        for(std::size_t i = 1; i < N; ++i)
+            if(sorted[i].key == sorted[i - 1].key)
+                return false;
+
+        return true;
+    }
+};
+
+/**
+ * @brief The sorted field table of a binding.
+ * @tparam T The bound struct.
+ */
+template<typename T>
+inline constexpr auto sConfFieldEntries = sConfFieldTable<T>::build(
+    std::make_index_sequence<std::tuple_size_v<typename sConfFieldTable<T>::Fields>>()
+);
+
+/**
+ * @class sConfBinder
+ * @brief Loads and saves a bound struct.
+ *
+ * The binding's fields are sorted by key into a table at compile time.
+ * Loading walks the section once and finds each key's field by binary
+ * search in that table, so the cost does not grow with the number of
+ * separate lookups a hand-written loader would make.
+ *
+ * @tparam T The bound struct.
+ */
+template<typename T>
+class sConfBinder {
+public:
+    /**
+     * @brief Loads a section into an existing object.
+     *
+     * Fields whose key is absent, or whose whole section is absent, keep
+     * their current values, so member initializers act as defaults. Keys
+     * without a field are ignored.
+     *
+     * @param parser The document to read.
+     * @param object The object to fill.
+     * @throws SconfException If a value does not convert to its field's type.
+     */
+    static void load(const sConfParser& parser, T& object) {
+        const sConfParser::Section* section = parser.find(sConfBinding<T>::section);
+        if(!section)
+            return;
+
+        for(const auto& [key, value] : *section) {
+            const Entry* entry = find(key);
+            if(entry && !entry->read(value, object)) {
+                std::optional<sConfLocation> location = parser.locate(sConfBinding<T>::section, key);
+
+                throw SconfException(
+                    (location ? location->toString() + ": " : std::string()) +
+                    "Invalid value for " + std::string(sConfBinding<T>::section) + "." + key
+                );
+            }
+        }
+    }
+
+    /**
+     * @brief Loads a section into a default-constructed object.
+     * @param parser The document to read.
+     * @return The loaded object.
+     * @throws SconfException If a value does not convert to its field's type.
+     */
+    static T load(const sConfParser& parser) {
+        T object{};
+        load(parser, object);
+
+        return object;
+    }
+
+    /**
+     * @brief Stores every field of an object into its section, creating
+     *        the section if needed.
+     * @param parser The document to write.
+     * @param object The object to store.
+     * @throws SconfException If a value cannot be set.
+     */
+    static void save(sConfParser& parser, const T& object) {
+        const std::string section = sConfBinding<T>::section;
+        parser.addSection(section);
+
+        for(const Entry& entry : sConfFieldEntries<T>)
+            parser.setKey(section, std::string(entry.key), entry.write(object));
+    }
+
+private:
+    using Entry = typename sConfFieldTable<T>::Entry;
+
+    /**
+     * @brief Finds the field bound to a key.
+     * @param key The key.
+     * @return The field's entry, or `nullptr` if no field is bound to it.
+     */
+    static const Entry* find(std::string_view key) noexcept {
+        const auto& table = sConfFieldEntries<T>;
+        std::size_t low = 0, high = table.size();
+
+        while(low < high) {
+            std::size_t middle = (low + high) / 2;
+            if(table[middle].key < key)
+                low = middle + 1;
+            else high = middle;
+        }
+
+        return low < table.size() && table[low].key == key ? &table[low] : nullptr;
+    }
+
+    static_assert(
+        sConfFieldTable<T>::unique(sConfFieldEntries<T>),
+        "sConfBinding binds two fields to the same key"
+    );
+};
+
+/**
+ * @brief Loads a bound struct from its section. See sConfBinder::load().
+ * @param parser The document to read.
+ * @param object The object to fill.
+ */
+template<typename T>
+void sConfLoad(const sConfParser& parser, T& object) {
+    sConfBinder<T>::load(parser, object);
+}
+
+/**
+ * @brief Saves a bound struct into its section. See sConfBinder::save().
+ * @param parser The document to write.
+ * @param object The object to store.
+ */
+template<typename T>
+void sConfSave(sConfParser& parser, const T& object) {
+    sConfBinder<T>::save(parser, object);
+}
+
+#define SCONF_BIND_EXPAND(x) x
+#define SCONF_BIND_CONCAT_(a, b) a##b
+#define SCONF_BIND_CONCAT(a, b) SCONF_BIND_CONCAT_(a, b)
+#define SCONF_BIND_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define SCONF_BIND_COUNT(...) SCONF_BIND_EXPAND(SCONF_BIND_COUNT_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define SCONF_BIND_FIELD(Struct, field) sConfField<&Struct::field>{#field}
+#define SCONF_BIND_1(Struct, field) SCONF_BIND_FIELD(Struct, field)
+#define SCONF_BIND_2(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_1(Struct, __VA_ARGS__))
+#define SCONF_BIND_3(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_2(Struct, __VA_ARGS__))
+#define SCONF_BIND_4(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_3(Struct, __VA_ARGS__))
+#define SCONF_BIND_5(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_4(Struct, __VA_ARGS__))
+#define SCONF_BIND_6(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_5(Struct, __VA_ARGS__))
+#define SCONF_BIND_7(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_6(Struct, __VA_ARGS__))
+#define SCONF_BIND_8(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_7(Struct, __VA_ARGS__))
+#define SCONF_BIND_9(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_8(Struct, __VA_ARGS__))
+#define SCONF_BIND_10(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_9(Struct, __VA_ARGS__))
+#define SCONF_BIND_11(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_10(Struct, __VA_ARGS__))
+#define SCONF_BIND_12(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_11(Struct, __VA_ARGS__))
+#define SCONF_BIND_13(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_12(Struct, __VA_ARGS__))
+#define SCONF_BIND_14(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_13(Struct, __VA_ARGS__))
+#define SCONF_BIND_15(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_14(Struct, __VA_ARGS__))
+#define SCONF_BIND_16(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_15(Struct, __VA_ARGS__))
+#define SCONF_BIND_17(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_16(Struct, __VA_ARGS__))
+#define SCONF_BIND_18(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_17(Struct, __VA_ARGS__))
+#define SCONF_BIND_19(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_18(Struct, __VA_ARGS__))
+#define SCONF_BIND_20(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_19(Struct, __VA_ARGS__))
+#define SCONF_BIND_21(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_20(Struct, __VA_ARGS__))
+#define SCONF_BIND_22(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_21(Struct, __VA_ARGS__))
+#define SCONF_BIND_23(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_22(Struct, __VA_ARGS__))
+#define SCONF_BIND_24(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_23(Struct, __VA_ARGS__))
+#define SCONF_BIND_25(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_24(Struct, __VA_ARGS__))
+#define SCONF_BIND_26(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_25(Struct, __VA_ARGS__))
+#define SCONF_BIND_27(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_26(Struct, __VA_ARGS__))
+#define SCONF_BIND_28(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_27(Struct, __VA_ARGS__))
+#define SCONF_BIND_29(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_28(Struct, __VA_ARGS__))
+#define SCONF_BIND_30(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_29(Struct, __VA_ARGS__))
+#define SCONF_BIND_31(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_30(Struct, __VA_ARGS__))
+#define SCONF_BIND_32(Struct, field, ...) SCONF_BIND_FIELD(Struct, field), SCONF_BIND_EXPAND(SCONF_BIND_31(Struct, __VA_ARGS__))
+
+/**
+ * @brief Binds up to 32 data members of a struct to the keys of the same
+ *        name in a section.
+ *
+ * Must be used at global scope, after the struct is defined:
+ *
+ * @code
+ * struct Server {
+ *     std::string host = "localhost";
+ *     int port = 8080;
+ * };
+ *
+ * SCONF_BIND(Server, "server", host, port)
+ *
+ * Server server = sConfBinder<Server>::load(parser);
+ * @endcode
+ *
+ * @param Struct The struct type.
+ * @param name The section name.
+ * @param ... The data members to bind.
+ */
+#define SCONF_BIND(Struct, name, ...)                                   \
+    template<>                                                          \
+    struct sConfBinding<Struct> {                                       \
+        static constexpr const char* section = name;                    \
+        static constexpr auto fields = std::make_tuple(                 \
+            SCONF_BIND_EXPAND(SCONF_BIND_CONCAT(                        \
+                SCONF_BIND_,                                            \
+                SCONF_BIND_COUNT(__VA_ARGS__)                           \
+            )(Struct, __VA_ARGS__))                                     \
+        );                                                              \
+    };
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_concurrent.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfConcurrent class, a thread-safe
+ *        front-end that publishes immutable sConfParser snapshots.
+ */
+#ifndef SCONF_CONCURRENT_HPP
+#define SCONF_CONCURRENT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sconf_parser.hpp>
+#include <string>
+#include <utility>
+
+/**
+ * @class sConfConcurrent
+ * @brief Read-mostly concurrent holder for a configuration document.
+ *
+ * Readers obtain an immutable snapshot of the document and never wait
+ * for a writer to parse or copy one. Writers build a new document version
+ * off to the side and publish it atomically (RCU-style): snapshots taken
+ * before the publication stay valid until their last holder releases them.
+ *
+ * Swapping the snapshot pointer relies on the `std::atomic_load` and
+ * `std::atomic_store` overloads for `std::shared_ptr`, which common
+ * standard libraries implement with a small internal lock held just long
+ * enough to copy the pointer. snapshot() is therefore short and bounded
+ * but not lock-free. For hot lookup paths, each thread should keep its
+ * own Reader, which caches the current snapshot and only calls snapshot()
+ * when a new version has been published, so its steady state is a single
+ * atomic load.
+ */
+class sConfConcurrent {
+public:
+    /**
+     * @brief Shared handle to an immutable document version.
+     */
+    using Snapshot = std::shared_ptr<const sConfParser>;
+
+    /**
+     * @class Reader
+     * @brief Per-thread cached view of an sConfConcurrent document.
+     *
+     * A Reader compares the published version counter with the one it
+     * has cached and reloads the snapshot only when they differ, so the
+     * steady-state read path is a single atomic load with no reference
+     * count traffic. A Reader must not be shared between threads.
+     */
+    class Reader {
+    public:
+        /**
+         * @brief Constructs a reader bound to a concurrent document.
+         * @param source The document to read from. Must outlive the reader.
+         */
+        explicit Reader(const sConfConcurrent& source) :
+            source(source),
+            cachedVersion(source.version()),
+            cached(source.snapshot()) {}
+
+        /**
+         * @brief Retrieves the latest published document.
+         * @return A reference valid until the next call on this reader.
+         */
+        const sConfParser& get();
+
+        /**
+         * @brief Member access to the latest published document.
+         * @return A pointer valid until the next call on this reader.
+         */
+        const sConfParser* operator->() {
+            return &this->get();
+        }
+
+        /**
+         * @brief Dereferences to the latest published document.
+         * @return A reference valid until the next call on this reader.
+         */
+        const sConfParser& operator*() {
+            return this->get();
+        }
+
+    private:
+        /**
+         * @brief The concurrent document being followed.
+         */
+        const sConfConcurrent& source;
+
+        /**
+         * @brief The version number of the cached snapshot.
+         *
+         * Read before the snapshot itself, so a publication racing with
+         * the refresh can only make the reader refresh once more.
+         */
+        std::uint64_t cachedVersion;
+
+        /**
+         * @brief The snapshot held since the last refresh.
+         */
+        Snapshot cached;
+    };
+
+    /**
+     * @brief Constructs a concurrent holder with an empty document.
+     */
+    sConfConcurrent() :
+        current(std::make_shared<const sConfParser>()),
+        generation(0) {}
+
+    /**
+     * @brief Constructs a concurrent holder publishing an initial document.
+     * @param parser The initial document.
+     */
+    explicit sConfConcurrent(sConfParser parser) :
+        current(std::make_shared<const sConfParser>(std::move(parser))),
+        generation(0) {}
+
+    sConfConcurrent(const sConfConcurrent&) = delete;
+    sConfConcurrent& operator=(const sConfConcurrent&) = delete;
+
+    /**
+     * @brief Retrieves the currently published document version.
+     *
+     * Takes the standard library's internal lock for atomic `shared_ptr`
+     * access while copying the handle; use a Reader to avoid it on hot
+     * paths.
+     *
+     * @return A shared handle to an immutable document.
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Retrieves the number of versions published so far.
+     * @return A counter incremented on every publication.
+     */
+    std::uint64_t version() const noexcept;
+
+    /**
+     * @brief Atomically replaces the published document.
+     * @param parser The new document version.
+     */
+    void publish(sConfParser parser);
+
+    /**
+     * @brief Atomically replaces the published document.
+     * @param snapshot The new document version. Must not be null.
+     * @throws SconfException If the snapshot is null.
+     */
+    void publish(Snapshot snapshot);
+
+    /**
+     * @brief Parses a file off to the side and publishes the result.
+     *
+     * Readers keep seeing the previous version while the file is parsed.
+     *
+     * @param filename The path to the file to load.
+     * @throws SconfException If the file cannot be opened or parsed, in
+     *         which case the published document is left untouched.
+     */
+    void load(const std::string& filename);
+
+    /**
+     * @brief Applies a modification to a copy of the current document and
+     *        publishes the copy.
+     *
+     * Concurrent updates are serialized against each other, but never
+     * against readers.
+     *
+     * @param mutator A callable taking `sConfParser&`.
+     */
+    template<typename Mutator>
+    void update(Mutator&& mutator) {
+        std::lock_guard<std::mutex> lock(this->writerMutex);
+
+        sConfParser next(*this->snapshot());
+        std::forward<Mutator>(mutator)(next);
+
+        this->store(std::make_shared<const sConfParser>(std::move(next)));
+    }
+
+private:
+    /**
+     * @brief Publishes a new snapshot and bumps the version counter.
+     * @param snapshot The new document version.
+     */
+    void store(Snapshot snapshot);
+
+    /**
+     * @brief The currently published document, accessed atomically.
+     */
+    Snapshot current;
+
+    /**
+     * @brief Publication counter polled by readers.
+     *
+     * Kept on its own cache line so that reader polling never shares
+     * a line with writer-side state.
+     */
+    alignas(64) std::atomic<std::uint64_t> generation;
+
+    /**
+     * @brief Serializes writers against each other.
+     */
+    alignas(64) std::mutex writerMutex;
+};
+
+#endif
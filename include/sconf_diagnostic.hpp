@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_diagnostic.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfDiagnostic structure, which describes
+ *        a problem found while parsing.
+ */
+#ifndef SCONF_DIAGNOSTIC_HPP
+#define SCONF_DIAGNOSTIC_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @struct sConfDiagnostic
+ * @brief A problem found while reading a configuration file.
+ */
+struct sConfDiagnostic {
+    /**
+     * @enum Kind
+     * @brief Enumerates the kinds of problems.
+     */
+    enum class Kind {
+        UnknownDirective,   ///< A line starts with `@` but is not `@include`.
+        MissingIncludePath, ///< An `@include` directive names no file.
+        InvalidKeyValue,    ///< A line is neither a header, comment nor `key = value`.
+        OpenFailed,         ///< The file could not be opened or read.
+        IncludeFailed,      ///< An included file could not be loaded.
+        InterpolationFailed ///< A `${...}` reference could not be resolved.
+    };
+
+    /**
+     * @brief The kind of problem.
+     */
+    Kind kind;
+
+    /**
+     * @brief The path of the file, or an empty string if unnamed.
+     */
+    std::string file;
+
+    /**
+     * @brief The 1-based line, or 0 if the problem is not tied to a line.
+     */
+    std::size_t line = 0;
+
+    /**
+     * @brief The 1-based column where the line's content starts, or 0.
+     */
+    std::size_t column = 0;
+
+    /**
+     * @brief Describes the problem, including the offending text.
+     */
+    std::string message;
+
+    /**
+     * @brief Formats the diagnostic for messages.
+     * @return `file:line: message`, `line N: message` if the file is
+     *         unnamed, or the bare message if there is no line.
+     */
+    std::string toString() const {
+        if(this->line == 0)
+            return this->message;
+
+        return (this->file.empty() ? "line " : this->file + ":") +
+            std::to_string(this->line) + ": " + this->message;
+    }
+};
+
+#endif
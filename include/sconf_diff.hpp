@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_diff.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file defining the sConfDiff class, which describes the
+ *        changes between two versions of a configuration document.
+ */
+#ifndef SCONF_DIFF_HPP
+#define SCONF_DIFF_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct sConfChange
+ * @brief A single added, removed or modified section or key.
+ */
+struct sConfChange {
+    /**
+     * @enum Kind
+     * @brief Enumerates the kinds of change.
+     */
+    enum class Kind {
+        Added,   ///< The entry exists only in the new version.
+        Removed, ///< The entry exists only in the old version.
+        Modified ///< The entry exists in both versions with different contents.
+    };
+
+    /**
+     * @brief The kind of change.
+     */
+    Kind kind;
+
+    /**
+     * @brief The name of the affected section.
+     */
+    std::string section;
+
+    /**
+     * @brief The affected key, or an empty string for a section-level change.
+     */
+    std::string key;
+};
+
+/**
+ * @class sConfDiff
+ * @brief Describes the changes between two versions of a document.
+ *
+ * Section-level and key-level changes are kept apart. Keys of added or
+ * removed sections are reported individually as added or removed keys.
+ */
+class sConfDiff {
+public:
+    /**
+     * @brief Records a section-level change.
+     * @param kind The kind of change.
+     * @param section The name of the section.
+     */
+    void addSectionChange(sConfChange::Kind kind, const std::string& section);
+
+    /**
+     * @brief Records a key-level change.
+     * @param kind The kind of change.
+     * @param section The name of the section holding the key.
+     * @param key The affected key.
+     */
+    void addKeyChange(sConfChange::Kind kind, const std::string& section, const std::string& key);
+
+    /**
+     * @brief Retrieves the section-level changes.
+     * @return The changed sections, in no particular order.
+     */
+    const std::vector<sConfChange>& getSectionChanges() const;
+
+    /**
+     * @brief Retrieves the key-level changes.
+     * @return The changed keys, grouped by section.
+     */
+    const std::vector<sConfChange>& getKeyChanges() const;
+
+    /**
+     * @brief Checks whether the two versions are identical.
+     * @return `true` if nothing changed, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+private:
+    /**
+     * @brief Section-level changes.
+     */
+    std::vector<sConfChange> sectionChanges;
+
+    /**
+     * @brief Key-level changes.
+     */
+    std::vector<sConfChange> keyChanges;
+};
+
+#endif
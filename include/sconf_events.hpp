@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_events.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the streaming, event-based sConf parser.
+ */
+#ifndef SCONF_EVENTS_HPP
+#define SCONF_EVENTS_HPP
+
+#include <cstddef>
+#include <istream>
+#include <sconf_diagnostic.hpp>
+#include <sconf_stats.hpp>
+#include <string>
+
+/**
+ * @class sConfHandler
+ * @brief Receives the events produced by an sConfEventParser.
+ *
+ * Every callback has an empty default implementation, so a handler only
+ * overrides the events it is interested in.
+ *
+ * Each key-value pair produces onKey() followed by exactly one value:
+ * either a single onValue() for a scalar, or onArrayBegin(), the element
+ * values (scalars and nested arrays) and onArrayEnd() for an array.
+ *
+ * Malformed lines are reported to onError(), which throws by default.
+ */
+class sConfHandler {
+public:
+    virtual ~sConfHandler() = default;
+
+    /**
+     * @brief Called for a `[section]` header.
+     * @param name The section name, trimmed and unquoted.
+     */
+    virtual void onSection(const std::string& name);
+
+    /**
+     * @brief Called for a full-line `;` comment.
+     * @param text The comment text, without the `;` and trimmed.
+     */
+    virtual void onComment(const std::string& text);
+
+    /**
+     * @brief Called for an `@include "path"` directive.
+     * @param path The path as written, unquoted.
+     */
+    virtual void onInclude(const std::string& path);
+
+    /**
+     * @brief Called for a key-value pair, before its value events.
+     * @param key The key, trimmed and unquoted.
+     * @param rawValue The value text, trimmed and without its inline comment.
+     */
+    virtual void onKey(const std::string& key, const std::string& rawValue);
+
+    /**
+     * @brief Called for a scalar value or array element.
+     * @param text The value text, trimmed and unquoted.
+     */
+    virtual void onValue(const std::string& text);
+
+    /**
+     * @brief Called when an array value starts.
+     */
+    virtual void onArrayBegin();
+
+    /**
+     * @brief Called when an array value ends.
+     */
+    virtual void onArrayEnd();
+
+    /**
+     * @brief Called for a line that is not valid sConf syntax; the line
+     *        produces no other event.
+     *
+     * The default implementation throws, stopping the parse.
+     *
+     * @param diagnostic The problem and its position.
+     * @return `true` to continue with the next line, `false` to stop
+     *         parsing the input.
+     * @throws SconfException With the formatted diagnostic as its message.
+     */
+    virtual bool onError(const sConfDiagnostic& diagnostic);
+};
+
+/**
+ * @class sConfEventParser
+ * @brief Streaming parser reporting sConf syntax to an sConfHandler.
+ *
+ * The event parser keeps no document: it reads its input one line at a
+ * time and reports what it finds, so it runs in memory proportional to the
+ * longest line regardless of the size of the input. sConfParser::load()
+ * is built on top of it.
+ */
+class sConfEventParser {
+public:
+    /**
+     * @brief Constructs an event parser.
+     * @param handler The handler receiving the events. Must outlive the parser.
+     * @param recorder Optional counters charged with the lines read and the
+     *        time spent scanning and tokenizing them.
+     */
+    explicit sConfEventParser(
+        sConfHandler& handler,
+        const sConfStatsRecorder* recorder = nullptr
+    ) :
+        handler(handler),
+        unrecorded(),
+        recorder(recorder ? *recorder : unrecorded),
+        source(),
+        lineNumber(0),
+        column(0),
+        valueColumn(0),
+        stopped(false),
+        partial() {}
+
+    sConfEventParser(const sConfEventParser&) = delete;
+    sConfEventParser& operator=(const sConfEventParser&) = delete;
+
+    /**
+     * @brief Parses a stream until its end, or until the handler's
+     *        onError() asks to stop.
+     * @param input The stream to read lines from.
+     * @throws SconfException If a line is not valid sConf syntax and the
+     *         handler does not override onError(); the message starts
+     *         with the source name and line number.
+     */
+    void parse(std::istream& input);
+
+    /**
+     * @brief Parses a file.
+     * @param filename The path to the file to parse.
+     * @throws SconfException If the file cannot be opened or a line is
+     *         not valid sConf syntax.
+     */
+    void parseFile(const std::string& filename);
+
+    /**
+     * @brief Parses a single line.
+     * @param line The line, without its terminator.
+     * @throws SconfException If the line is not valid sConf syntax.
+     */
+    void parseLine(const std::string& line);
+
+    /**
+     * @brief Parses the next chunk of an input arriving piecewise.
+     *
+     * Every complete line in the chunk is parsed immediately; a trailing
+     * incomplete line is kept until a later chunk completes it, so chunks
+     * may split lines anywhere, even inside a key, a quoted string or an
+     * array. Only that incomplete line is buffered.
+     *
+     * @param data The bytes of the chunk.
+     * @param size The number of bytes.
+     * @throws SconfException If a line is not valid sConf syntax and the
+     *         handler does not override onError().
+     */
+    void feed(const char* data, std::size_t size);
+
+    /**
+     * @brief Parses the last line of a fed input if it has no terminator.
+     * @throws SconfException If the line is not valid sConf syntax and the
+     *         handler does not override onError().
+     */
+    void finish();
+
+    /**
+     * @brief Names the input and sets the number of lines before the next
+     *        one, for parsing that starts in the middle of a file.
+     * @param source The name reported in errors, usually the file path.
+     * @param lineNumber The number of lines preceding the next line.
+     */
+    void setPosition(const std::string& source, std::size_t lineNumber);
+
+    /**
+     * @brief Retrieves the name of the input, as given to parseFile() or
+     *        setPosition().
+     * @return The name, or an empty string if none was given.
+     */
+    const std::string& getSource() const;
+
+    /**
+     * @brief Retrieves the number of lines parsed so far.
+     *
+     * While a handler callback runs, this is the 1-based number of the
+     * line that produced the event, counted from the first line given to
+     * this parser.
+     *
+     * @return The number of lines parsed.
+     */
+    std::size_t getLineNumber() const;
+
+    /**
+     * @brief Retrieves the 1-based column where the current line's content
+     *        starts: the `[` of a section header or the first character of
+     *        a key.
+     * @return The column, in bytes.
+     */
+    std::size_t getColumn() const;
+
+    /**
+     * @brief Retrieves the 1-based column where the current key's value
+     *        starts.
+     * @return The column, in bytes; only meaningful during onKey() and the
+     *         value events following it.
+     */
+    std::size_t getValueColumn() const;
+
+    /**
+     * @brief Checks whether the handler's onError() asked to stop.
+     * @return `true` if parse() stopped early.
+     */
+    bool isStopped() const;
+
+    /**
+     * @brief Makes parse() return once the current line is handled.
+     */
+    void stop();
+
+private:
+    /**
+     * @brief Reports a malformed current line to the handler.
+     * @param kind The kind of problem.
+     * @param message Describes the problem.
+     */
+    void fail(sConfDiagnostic::Kind kind, const std::string& message);
+
+    /**
+     * @brief Emits the events for the elements of an array value.
+     * @param value The array text, including its brackets.
+     */
+    void parseArray(const std::string& value);
+
+    /**
+     * @brief The handler receiving the events.
+     */
+    sConfHandler& handler;
+
+    /**
+     * @brief Private counters used when no recorder was given.
+     */
+    sConfStatsRecorder unrecorded;
+
+    /**
+     * @brief The counters to record into.
+     */
+    const sConfStatsRecorder& recorder;
+
+    /**
+     * @brief The name of the input.
+     */
+    std::string source;
+
+    /**
+     * @brief The number of lines parsed so far.
+     */
+    std::size_t lineNumber;
+
+    /**
+     * @brief The column where the current line's content starts.
+     */
+    std::size_t column;
+
+    /**
+     * @brief The column where the current key's value starts.
+     */
+    std::size_t valueColumn;
+
+    /**
+     * @brief Whether the handler asked to stop parsing.
+     */
+    bool stopped;
+
+    /**
+     * @brief The incomplete last line of the chunks given to feed().
+     */
+    std::string partial;
+};
+
+#endif
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_interpolation.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfInterpolation class, the dependency
+ *        graph behind `${section.key}` and `${ENV:VAR}` references.
+ */
+#ifndef SCONF_INTERPOLATION_HPP
+#define SCONF_INTERPOLATION_HPP
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class sConfInterpolation
+ * @brief Dependency graph of string values that reference other values.
+ *
+ * A template is a string value containing `${section.key}` references to
+ * other keys of the document, or `${ENV:VAR}` references to environment
+ * variables. `$${` stands for a literal `${`. The section name is
+ * everything before the last dot, so section names may contain dots.
+ *
+ * The graph keeps the unexpanded text of every template together with
+ * the reverse edges from each referenced key to the templates using it,
+ * so that a change to one key yields exactly the templates that have to
+ * be expanded again, in dependency order.
+ */
+class sConfInterpolation {
+public:
+    /**
+     * @struct Key
+     * @brief Identifies a key of the document.
+     */
+    struct Key {
+        /**
+         * @brief The section name.
+         */
+        std::string section;
+
+        /**
+         * @brief The key name.
+         */
+        std::string key;
+    };
+
+    /**
+     * @struct Reference
+     * @brief A `${...}` reference found in a template.
+     */
+    struct Reference {
+        /**
+         * @brief Whether the reference names an environment variable.
+         */
+        bool environment;
+
+        /**
+         * @brief The referenced key; for environment references only
+         *        `key` is set and holds the variable name.
+         */
+        Key target;
+    };
+
+    /**
+     * @brief Callback producing the text substituted for a reference.
+     */
+    using Resolver = std::function<std::string(const Reference&)>;
+
+    /**
+     * @brief Checks whether a string would be treated as a template.
+     * @param text The string to check.
+     * @return `true` if the string contains `${`.
+     */
+    static bool isTemplate(const std::string& text);
+
+    /**
+     * @brief Extracts the references of a template.
+     * @param text The template text.
+     * @return The references, in order of appearance.
+     * @throws SconfException If a reference is unterminated or malformed.
+     */
+    static std::vector<Reference> references(const std::string& text);
+
+    /**
+     * @brief Checks whether a template consists of a single reference and
+     *        nothing else, in which case the referenced value is used as
+     *        is rather than converted to text.
+     * @param text The template text.
+     * @param reference Receives the reference, if the check succeeds.
+     * @return `true` if the template is exactly one reference.
+     */
+    static bool isWholeReference(const std::string& text, Reference& reference);
+
+    /**
+     * @brief Substitutes every reference of a template.
+     * @param text The template text.
+     * @param resolve Callback producing the text of each reference.
+     * @return The expanded string.
+     * @throws SconfException If the template is malformed, or whatever the
+     *         resolver throws.
+     */
+    static std::string expand(const std::string& text, const Resolver& resolve);
+
+    /**
+     * @brief Records or replaces the template of a key.
+     * @param key The key holding the template.
+     * @param text The unexpanded template text.
+     * @throws SconfException If the template is malformed; the graph is
+     *         left unchanged.
+     */
+    void set(const Key& key, const std::string& text);
+
+    /**
+     * @brief Forgets the template of a key, if any.
+     * @param key The key.
+     */
+    void erase(const Key& key);
+
+    /**
+     * @brief Forgets the templates of every key of a section.
+     * @param section The section name.
+     */
+    void eraseSection(const std::string& section);
+
+    /**
+     * @brief Retrieves the unexpanded template of a key.
+     * @param key The key.
+     * @return A pointer to the template text, or `nullptr` if the key does
+     *         not hold a template.
+     */
+    const std::string* find(const Key& key) const;
+
+    /**
+     * @brief Checks whether the graph holds no template.
+     * @return `true` if there are no templates.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Retrieves every template key.
+     * @return The template keys, in no particular order.
+     */
+    std::vector<Key> keys() const;
+
+    /**
+     * @brief Orders every template so that each comes after the templates
+     *        it references.
+     * @return The template keys in dependency order.
+     * @throws SconfException If the references form a cycle.
+     */
+    std::vector<Key> order() const;
+
+    /**
+     * @brief Orders the templates affected by a change to one key.
+     *
+     * The result holds the key itself, if it is a template, followed by
+     * every template that references it directly or transitively, each
+     * after the affected templates it references.
+     *
+     * @param key The changed key.
+     * @return The affected template keys in dependency order.
+     * @throws SconfException If the affected templates form a cycle.
+     */
+    std::vector<Key> dependents(const Key& key) const;
+
+private:
+    /**
+     * @struct Node
+     * @brief A template and the keys it references.
+     */
+    struct Node {
+        /**
+         * @brief The template's own key.
+         */
+        Key key;
+
+        /**
+         * @brief The unexpanded template text.
+         */
+        std::string text;
+
+        /**
+         * @brief Identifiers of the keys the template references.
+         */
+        std::vector<std::string> uses;
+    };
+
+    /**
+     * @brief Builds the map identifier of a key.
+     * @param key The key.
+     * @return A string unique to the section and key pair.
+     */
+    static std::string id(const Key& key);
+
+    /**
+     * @brief Formats a key as it is written in a reference.
+     * @param key The key.
+     * @return The text `section.key`.
+     */
+    static std::string name(const Key& key);
+
+    /**
+     * @brief Removes the reverse edges of a template.
+     * @param identifier The template's identifier.
+     * @param node The template.
+     */
+    void unlink(const std::string& identifier, const Node& node);
+
+    /**
+     * @brief Depth-first visit appending a template after its dependencies.
+     * @param identifier The template to visit.
+     * @param include Templates to append; `nullptr` appends every template.
+     * @param marks Visit state per identifier: 1 while on the stack, 2 when done.
+     * @param path The templates currently on the stack, to report cycles.
+     * @param result Receives the ordered keys.
+     * @throws SconfException If a cycle is found.
+     */
+    void visit(
+        const std::string& identifier,
+        const std::unordered_set<std::string>* include,
+        std::unordered_map<std::string, int>& marks,
+        std::vector<std::string>& path,
+        std::vector<Key>& result
+    ) const;
+
+    /**
+     * @brief Templates by key identifier.
+     */
+    std::unordered_map<std::string, Node> templates;
+
+    /**
+     * @brief Reverse edges: identifiers of the templates using each key.
+     */
+    std::unordered_map<std::string, std::vector<std::string>> users;
+};
+
+#endif
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_layered.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfLayered class, which stacks several
+ *        documents with precedence rules.
+ */
+#ifndef SCONF_LAYERED_HPP
+#define SCONF_LAYERED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sconf_parser.hpp>
+#include <sconf_value.hpp>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class sConfLayered
+ * @brief A stack of sConfParser layers read as one document.
+ *
+ * Layers are ordered by precedence: a layer added later overrides the
+ * layers below it, key by key, so a typical stack reads defaults, region,
+ * cluster and host overrides in that order.
+ *
+ * The winning layer of every key is kept in a precomputed index, so a
+ * lookup is a single hash probe regardless of the number of layers.
+ * Replacing or removing a layer only revisits the index entries of the
+ * keys that layer held before or holds after the change.
+ *
+ * Section and key names are normalized like sConfParser normalizes them
+ * at load time (surrounding whitespace and one pair of quotes are
+ * dropped), without building a string per lookup. Const member functions
+ * may be called concurrently; modifications need external synchronization.
+ */
+class sConfLayered {
+public:
+    /**
+     * @brief Constructs an empty stack.
+     */
+    sConfLayered() :
+        layers(),
+        index(),
+        sectionKeys() {}
+
+    sConfLayered(const sConfLayered&) = delete;
+    sConfLayered& operator=(const sConfLayered&) = delete;
+
+    /**
+     * @brief Adds a layer on top of the stack.
+     * @param name A name identifying the layer.
+     * @param layer The layer's document.
+     * @throws SconfException If a layer with the same name exists.
+     */
+    void addLayer(const std::string& name, const sConfParser& layer);
+
+    /**
+     * @brief Replaces the document of an existing layer, keeping its
+     *        position in the stack.
+     * @param name The name of the layer.
+     * @param layer The layer's new document.
+     * @throws SconfException If the layer does not exist.
+     */
+    void setLayer(const std::string& name, const sConfParser& layer);
+
+    /**
+     * @brief Removes a layer from the stack.
+     * @param name The name of the layer.
+     * @throws SconfException If the layer does not exist.
+     */
+    void removeLayer(const std::string& name);
+
+    /**
+     * @brief Retrieves the document of a layer.
+     * @param name The name of the layer.
+     * @return The layer's document.
+     * @throws SconfException If the layer does not exist.
+     */
+    const sConfParser& getLayer(const std::string& name) const;
+
+    /**
+     * @brief Retrieves the layer names, from lowest to highest precedence.
+     * @return The layer names.
+     */
+    std::vector<std::string> getLayerNames() const;
+
+    /**
+     * @brief Retrieves the sections holding at least one key in any layer.
+     * @return The section names, in no particular order.
+     */
+    std::vector<std::string> getSections() const;
+
+    /**
+     * @brief Checks whether any layer defines a key.
+     * @param section The name of the section.
+     * @param key The key to check.
+     * @return `true` if the key is defined, `false` otherwise.
+     */
+    bool hasKey(std::string_view section, std::string_view key) const;
+
+    /**
+     * @brief Retrieves the effective value of a key.
+     * @param section The name of the section.
+     * @param key The key to retrieve.
+     * @return The value from the highest layer defining the key. The
+     *         reference stays valid until that layer is replaced or removed.
+     * @throws SconfException If no layer defines the key.
+     */
+    const sConfValue& getValue(std::string_view section, std::string_view key) const;
+
+    /**
+     * @brief Retrieves the layer supplying the effective value of a key.
+     * @param section The name of the section.
+     * @param key The key to look up.
+     * @return The name of the highest layer defining the key.
+     * @throws SconfException If no layer defines the key.
+     */
+    const std::string& getWinningLayer(std::string_view section, std::string_view key) const;
+
+    /**
+     * @brief Builds a single document holding the effective value of
+     *        every key.
+     *
+     * Section comments are not carried over.
+     *
+     * @return The flattened document.
+     */
+    sConfParser flatten() const;
+
+private:
+    /**
+     * @struct Layer
+     * @brief One document of the stack and its values by key.
+     */
+    struct Layer {
+        /**
+         * @brief The layer name.
+         */
+        std::string name;
+
+        /**
+         * @brief Position in the stack; higher ranks take precedence.
+         */
+        std::size_t rank;
+
+        /**
+         * @brief The layer's document.
+         */
+        sConfParser document;
+
+        /**
+         * @brief The layer's values, keyed by the identifier of their
+         *        section and key.
+         */
+        std::unordered_map<std::string, sConfValue> values;
+    };
+
+    /**
+     * @struct Winner
+     * @brief Index entry pointing at the effective value of a key.
+     */
+    struct Winner {
+        /**
+         * @brief The layer supplying the value.
+         */
+        const Layer* layer;
+
+        /**
+         * @brief The value, owned by the layer.
+         */
+        const sConfValue* value;
+
+        /**
+         * @brief The identifier of the section and key, owned by the layer.
+         */
+        const std::string* identifier;
+    };
+
+    /**
+     * @brief Builds the identifier of a section and key.
+     * @param section The section name.
+     * @param key The key name.
+     * @return A string unique to the section and key pair.
+     */
+    static std::string id(const std::string& section, const std::string& key);
+
+    /**
+     * @brief Hashes a section and key the way the index is keyed.
+     * @param section The normalized section name.
+     * @param key The normalized key name.
+     * @return The hash.
+     */
+    static std::uint64_t hash(std::string_view section, std::string_view key);
+
+    /**
+     * @brief Checks whether an identifier names a section and key.
+     * @param identifier The identifier.
+     * @param section The normalized section name.
+     * @param key The normalized key name.
+     * @return `true` if the identifier was built from them.
+     */
+    static bool matches(const std::string& identifier, std::string_view section, std::string_view key);
+
+    /**
+     * @brief Collects the values of a document by identifier.
+     * @param document The document.
+     * @return The document's values.
+     */
+    static std::unordered_map<std::string, sConfValue> collect(const sConfParser& document);
+
+    /**
+     * @brief Finds a layer by name.
+     * @param name The layer name.
+     * @return The layer.
+     * @throws SconfException If the layer does not exist.
+     */
+    Layer& findLayer(const std::string& name) const;
+
+    /**
+     * @brief Looks up the index entry of a key.
+     * @param section The normalized section name.
+     * @param key The normalized key name.
+     * @return The entry, or `nullptr` if no layer defines the key.
+     */
+    const Winner* lookup(std::string_view section, std::string_view key) const noexcept;
+
+    /**
+     * @brief Finds the index entry of a key.
+     * @param section The section name, normalized first.
+     * @param key The key name, normalized first.
+     * @return The entry.
+     * @throws SconfException If no layer defines the key.
+     */
+    const Winner& findWinner(std::string_view section, std::string_view key) const;
+
+    /**
+     * @brief Makes a layer's values win wherever no higher layer defines
+     *        the same key.
+     * @param layer The layer.
+     */
+    void claim(const Layer& layer);
+
+    /**
+     * @brief Hands the keys a layer no longer defines, or no longer may
+     *        supply, to the next lower layer defining them.
+     * @param layer The layer that held the keys.
+     * @param values The values the layer held.
+     */
+    void release(const Layer& layer, const std::unordered_map<std::string, sConfValue>& values);
+
+    /**
+     * @brief Stores the index entry of a key, keeping section counts.
+     * @param identifier The key's identifier.
+     * @param winner The new entry, or one with a null layer to erase it.
+     */
+    void assign(const std::string& identifier, Winner winner);
+
+    /**
+     * @brief The layers, from lowest to highest precedence.
+     */
+    std::vector<std::unique_ptr<Layer>> layers;
+
+    /**
+     * @brief Winning layer and value of every defined key, keyed by
+     *        hash().
+     *
+     * Keyed by hash rather than by identifier so that a lookup can probe
+     * it with the caller's string views; entries sharing a hash are told
+     * apart by their identifier.
+     */
+    std::unordered_multimap<std::uint64_t, Winner> index;
+
+    /**
+     * @brief Number of defined keys per section.
+     */
+    std::unordered_map<std::string, std::size_t> sectionKeys;
+};
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_location.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfLocation structure, which points at
+ *        the source text of a section or key.
+ */
+#ifndef SCONF_LOCATION_HPP
+#define SCONF_LOCATION_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @struct sConfLocation
+ * @brief The position of a section header or key-value pair in its file.
+ *
+ * Lines and columns are 1-based; columns count bytes.
+ */
+struct sConfLocation {
+    /**
+     * @brief The path of the file, as it was given to the load.
+     */
+    std::string file;
+
+    /**
+     * @brief The line of the section header or key.
+     */
+    std::size_t line = 0;
+
+    /**
+     * @brief The column of the `[` of a section header or of the key.
+     */
+    std::size_t column = 0;
+
+    /**
+     * @brief The column where the value starts, or 0 for a section.
+     */
+    std::size_t valueColumn = 0;
+
+    /**
+     * @brief Formats the location for messages.
+     * @return `file:line:column`.
+     */
+    std::string toString() const {
+        return this->file + ":" + std::to_string(this->line) + ":" + std::to_string(this->column);
+    }
+};
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_memory.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfMemoryUsage structure, which reports
+ *        the heap footprint of an sConfParser document.
+ */
+#ifndef SCONF_MEMORY_HPP
+#define SCONF_MEMORY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @struct sConfMemoryUsage
+ * @brief Heap bytes held by a document, broken down by section and by kind
+ *        of storage.
+ *
+ * Sizes are the bytes requested from the allocator, estimated from the
+ * sizes and capacities of the containers involved; allocator bookkeeping
+ * is not included. Hash tables are accounted as one bucket pointer per
+ * bucket plus one node per element, each node holding a link, the cached
+ * hash and the element.
+ */
+struct sConfMemoryUsage {
+    /**
+     * @struct SectionUsage
+     * @brief Heap bytes held by a single section.
+     */
+    struct SectionUsage {
+        /**
+         * @brief The name of the section.
+         */
+        std::string name;
+
+        /**
+         * @brief Number of key-value pairs in the section.
+         */
+        std::size_t keys = 0;
+
+        /**
+         * @brief Bytes held by key strings, and by the section name itself.
+         */
+        std::size_t keyBytes = 0;
+
+        /**
+         * @brief Bytes held by the text of scalar values.
+         */
+        std::size_t valueBytes = 0;
+
+        /**
+         * @brief Bytes held by array element buffers and their contents.
+         */
+        std::size_t arrayBytes = 0;
+
+        /**
+         * @brief Bytes held by the section's hash table and its entry in
+         *        the document's section table.
+         */
+        std::size_t tableBytes = 0;
+
+        /**
+         * @brief Bytes held by the comments attached to the section.
+         */
+        std::size_t commentBytes = 0;
+
+        /**
+         * @brief Bytes of source text not parsed into the section yet.
+         *
+         * Non-zero only for lazily loaded sections that were never read;
+         * their keys and values are not counted until they are. These
+         * bytes are part of `sourceBytes` and not included in total().
+         */
+        std::size_t pendingBytes = 0;
+
+        /**
+         * @brief Whether the section's storage is shared with copies of
+         *        the document, in which case its bytes are counted once
+         *        per document holding it.
+         */
+        bool shared = false;
+
+        /**
+         * @brief Computes the total bytes held by the section.
+         * @return The sum of all categories.
+         */
+        std::size_t total() const;
+    };
+
+    /**
+     * @brief Per-section usage, ordered by section name.
+     */
+    std::vector<SectionUsage> sections;
+
+    /**
+     * @brief Bytes held by key strings and section names.
+     */
+    std::size_t keyBytes = 0;
+
+    /**
+     * @brief Bytes held by the text of scalar values.
+     */
+    std::size_t valueBytes = 0;
+
+    /**
+     * @brief Bytes held by array element buffers and their contents.
+     */
+    std::size_t arrayBytes = 0;
+
+    /**
+     * @brief Bytes held by all hash tables, including the document's
+     *        section and comment tables.
+     */
+    std::size_t tableBytes = 0;
+
+    /**
+     * @brief Bytes held by comments.
+     */
+    std::size_t commentBytes = 0;
+
+    /**
+     * @brief Bytes of file contents retained by lazily loaded sections.
+     */
+    std::size_t sourceBytes = 0;
+
+    /**
+     * @brief Bytes of source text belonging to sections not parsed yet.
+     *
+     * A part of `sourceBytes`, and so not counted again by total().
+     */
+    std::size_t pendingBytes = 0;
+
+    /**
+     * @brief Computes the total bytes held by the document.
+     * @return The sum of all categories.
+     */
+    std::size_t total() const;
+
+    /**
+     * @brief Retrieves the sections holding the most memory.
+     * @param count The maximum number of sections to return.
+     * @return Up to `count` sections, largest first.
+     */
+    std::vector<SectionUsage> largest(std::size_t count) const;
+
+    /**
+     * @brief Formats a human-readable summary of the usage.
+     * @param topCount The number of largest sections to list.
+     * @return The totals per category followed by the largest sections.
+     */
+    std::string report(std::size_t topCount = 10) const;
+};
+
+#endif
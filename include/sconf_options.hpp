@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_options.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfLoadOptions structure, which tunes how
+ *        sConfParser loads configuration files.
+ */
+#ifndef SCONF_OPTIONS_HPP
+#define SCONF_OPTIONS_HPP
+
+#include <cstddef>
+
+/**
+ * @struct sConfLoadOptions
+ * @brief Options accepted by sConfParser::load().
+ */
+struct sConfLoadOptions {
+    /**
+     * @brief Defers parsing each section until it is first read.
+     *
+     * The load only scans for section headers and comments, keeping the
+     * file contents and the byte ranges of every section. A section's
+     * key-value pairs are parsed the first time it is accessed, so syntax
+     * errors in a section surface from that access rather than from load().
+     */
+    bool lazySections = false;
+
+    /**
+     * @brief Gives values the type inferred from their text.
+     *
+     * By default every scalar is loaded as a String holding its text, as
+     * written and without quotes, and only the typed getters parse it, so
+     * getString() works on every scalar (see sConfValue::fromText()).
+     * With this option set, unquoted text such as `8080`, `true`, `250ms`
+     * or `64MiB` becomes an Integer, a Boolean, a Duration or a Size, and
+     * only quoted text remains a String (see sConfValue::fromRaw()).
+     */
+    bool inferTypes = false;
+
+    /**
+     * @brief Defers decoding each value until it is first read.
+     *
+     * Values keep their raw text after loading; their type is inferred
+     * and the typed value decoded and cached by the first getter call.
+     */
+    bool lazyValues = false;
+
+    /**
+     * @brief Resolves `${section.key}` and `${ENV:VAR}` references once
+     *        the file is loaded. See sConfParser::interpolate().
+     *
+     * With lazySections, only sections whose text contains `${` and the
+     * sections they reference are parsed.
+     */
+    bool interpolate = false;
+
+    /**
+     * @brief The number of problems after which sConfParser::tryLoad()
+     *        stops reading, or 0 for no limit. Ignored by load().
+     */
+    std::size_t maxErrors = 100;
+};
+
+#endif
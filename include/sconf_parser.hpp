@@ -26,8 +26,26 @@
 #ifndef SCONF_PARSER_HPP
 #define SCONF_PARSER_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sconf_diagnostic.hpp>
+#include <sconf_diff.hpp>
+#include <sconf_events.hpp>
+#include <sconf_interpolation.hpp>
+#include <sconf_location.hpp>
+#include <sconf_memory.hpp>
+#include <sconf_options.hpp>
+#include <sconf_result.hpp>
+#include <sconf_stats.hpp>
+#include <sconf_subscriptions.hpp>
 #include <sconf_value.hpp>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -38,24 +56,640 @@
  * The sConfParser class provides functionality to load, parse, modify, 
  * and save structured configuration files. It supports sections, key-value 
  * pairs, arrays, and comments associated with sections.
+ *
+ * Documents are persistent: copies share their sections and only clone
+ * the parts they modify, which makes it cheap to keep many lightly
+ * diverging versions of one configuration in memory.
  */
 class sConfParser {
+public:
+    /**
+     * @brief Key-value pairs of a single section.
+     */
+    using Section = std::unordered_map<std::string, sConfValue>;
+
 private:
+    /**
+     * @brief Where a section header or key was read from.
+     */
+    struct SourcePosition {
+        /**
+         * @brief Identifier of the file in the process-wide file table,
+         *        or 0 if unknown.
+         */
+        std::uint32_t file = 0;
+
+        /**
+         * @brief The 1-based line, or 0 if unknown.
+         */
+        std::uint32_t line = 0;
+
+        /**
+         * @brief The 1-based column.
+         */
+        std::uint32_t column = 0;
+    };
+
+    /**
+     * @brief Packed source location of one key-value pair.
+     */
+    struct KeySpan {
+        /**
+         * @brief Hash of the key, used to find the span without storing
+         *        the key again.
+         */
+        std::uint64_t keyHash;
+
+        /**
+         * @brief Where the key starts.
+         */
+        SourcePosition key;
+
+        /**
+         * @brief The 1-based column where the value starts.
+         */
+        std::uint32_t valueColumn;
+    };
+
+    /**
+     * @brief Source locations of the keys of a section.
+     *
+     * Entries are appended in load order and stable-sorted by key hash on
+     * the first lookup, so the last span of a key loaded twice wins.
+     */
+    struct SpanTable {
+        /**
+         * @brief The spans, in load order until `sorted` is set.
+         */
+        std::vector<KeySpan> entries;
+
+        /**
+         * @brief Whether `entries` has been sorted; it is not modified
+         *        afterwards.
+         */
+        bool sorted = false;
+
+        /**
+         * @brief Ensures the entries are sorted exactly once.
+         */
+        std::once_flag sorting;
+    };
+
+    /**
+     * @brief Unparsed source text of a lazily loaded section.
+     */
+    struct PendingSection {
+        /**
+         * @brief The contents of the file the section was loaded from.
+         */
+        std::shared_ptr<const std::string> source;
+
+        /**
+         * @brief Byte ranges of the section's key-value lines in `source`.
+         */
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+
+        /**
+         * @brief The line number of the first line of each range.
+         */
+        std::vector<std::uint32_t> lines;
+
+        /**
+         * @brief Identifier of the file in the process-wide file table.
+         */
+        std::uint32_t file = 0;
+
+        /**
+         * @brief Whether values are left undecoded until first read.
+         */
+        bool deferValues = false;
+
+        /**
+         * @brief Whether values get the type inferred from their text.
+         */
+        bool inferTypes = false;
+
+        /**
+         * @brief Ensures the ranges are parsed exactly once.
+         */
+        std::once_flag parsed;
+
+        /**
+         * @brief The error raised while parsing the ranges, if any, thrown
+         *        again on every later access.
+         */
+        std::exception_ptr failure;
+
+        /**
+         * @brief Set once the ranges have been parsed into the section, so
+         *        that reports can tell without parsing them.
+         */
+        std::atomic<bool> materialized{false};
+    };
+
+    /**
+     * @brief A section together with the hash of the text it was parsed from.
+     */
+    struct SectionNode {
+        /**
+         * @brief The key-value pairs of the section.
+         *
+         * Incomplete while `pending` has not been parsed; read through
+         * materialize().
+         */
+        Section pairs;
+
+        /**
+         * @brief Hash of the section's source lines, or 0 if the section
+         *        has been modified since it was loaded.
+         */
+        std::uint64_t sourceHash = 0;
+
+        /**
+         * @brief Hash of the offsets of the section's lines from its first
+         *        one; see SectionHashes::Entry.
+         */
+        std::uint64_t sourceLayout = 0;
+
+        /**
+         * @brief The first line of the section's content when it was
+         *        hashed, which the line delta of a reused section is
+         *        measured from.
+         */
+        std::uint32_t sourceLine = 0;
+
+        /**
+         * @brief Source text still to be parsed into `pairs`, or `nullptr`.
+         */
+        std::shared_ptr<PendingSection> pending;
+
+        /**
+         * @brief Where the section's first header was read from.
+         */
+        SourcePosition header;
+
+        /**
+         * @brief Where the section's keys were read from, or `nullptr`.
+         *
+         * Shared between copies of the node and cloned before appending.
+         * Incomplete while `pending` has not been parsed.
+         */
+        std::shared_ptr<SpanTable> spans;
+    };
+
+    /**
+     * @brief Table of sections, each held by a shared node.
+     */
+    using SectionTable = std::unordered_map<std::string, std::shared_ptr<SectionNode>>;
+
+    /**
+     * @brief Table of section comments.
+     */
+    using CommentTable = std::unordered_map<std::string, std::vector<std::string>>;
+
     /**
      * @brief Storage for configuration data.
      *
      * Organized as a map where:
      * - The key is the section name.
-     * - The value is another map of key-value pairs for that section.
+     * - The value is a shared node holding the key-value pairs for that section.
+     *
+     * Both the table and its section nodes are structurally shared between
+     * copies of a parser and cloned on first write, so copying a parser is
+     * O(1) and a modification only clones the table and the touched section.
      */
-    std::unordered_map<std::string, std::unordered_map<std::string, sConfValue>> data;
+    std::shared_ptr<SectionTable> data;
 
     /**
      * @brief Storage for section comments.
      *
-     * Maps each section name to its associated vector of comments.
+     * Maps each section name to its associated vector of comments. Shared
+     * between copies and cloned on first write, like `data`.
+     */
+    std::shared_ptr<CommentTable> comments;
+
+    /**
+     * @brief Templates of interpolated values and their dependency graph.
+     *
+     * Null until interpolate() is first called; while set, setKey()
+     * expands the templates depending on the key it changes. Shared between
+     * copies and cloned on first write, like `data`.
+     */
+    std::shared_ptr<sConfInterpolation> interpolation;
+
+    /**
+     * @brief Whether values are loaded with the type inferred from their
+     *        text, as chosen by the last load; reload(), included files
+     *        and interpolation create values the same way.
+     */
+    bool inferTypes;
+
+    /**
+     * @brief Change callbacks registered on this document.
+     *
+     * Never carried over by copying or moving the parser, nor replaced by
+     * assigning to it; see sConfSubscriptions.
+     */
+    sConfSubscriptions subscriptions;
+
+    /**
+     * @brief Parse and lookup counters; unallocated unless
+     *        `SCONF_ENABLE_STATS` is defined.
+     */
+    sConfStatsRecorder statsRecorder;
+
+    /**
+     * @brief Looks up a section without copying anything.
+     * @param section The already-normalized section name.
+     * @return A pointer to the section, or `nullptr` if it does not exist.
      */
-    std::unordered_map<std::string, std::vector<std::string>> comments;
+    const Section* findSection(const std::string& section) const;
+
+    /**
+     * @brief Parses a lazily loaded section if that has not happened yet.
+     *
+     * Safe to call concurrently on a shared document.
+     *
+     * @param node The section node.
+     * @return The section's complete key-value pairs.
+     * @throws SconfException If the section's source text is invalid.
+     */
+    const Section& materialize(SectionNode& node) const;
+
+    /**
+     * @brief Loads a file by indexing its sections for later parsing.
+     * @param filename The path to the file to load.
+     * @param deferValues Whether values are left undecoded until first read.
+     * @return The resolved paths of the files included by the file.
+     * @throws SconfException If the file cannot be opened.
+     */
+    std::vector<std::string> loadLazy(const std::string& filename, bool deferValues);
+
+    /**
+     * @brief A parsed included file, before its own includes are applied.
+     */
+    struct IncludedFile {
+        /**
+         * @brief The file's own sections and comments.
+         */
+        std::shared_ptr<const sConfParser> document;
+
+        /**
+         * @brief The resolved paths of the files it includes, in order.
+         */
+        std::vector<std::string> includes;
+    };
+
+    /**
+     * @class IncludeCache
+     * @brief Process-wide cache of parsed included files, keyed by path
+     *        and validated by inode, modification time and size.
+     *
+     * Files are parsed on a pool of at most `hardware_concurrency` worker
+     * threads, started on demand, and each result is published through a
+     * future that never blocks when released, so dropping an entry does
+     * not wait for a parse still in flight; the cache outlives the workers
+     * by waiting for them when the process exits. An entry whose parse
+     * could not be started is not kept.
+     */
+    class IncludeCache;
+
+    /**
+     * @brief Parses an included file; run on a worker of IncludeCache.
+     * @param path The resolved path of the file.
+     * @param inferTypes Whether values get the type inferred from their text.
+     * @return The parsed file.
+     * @throws SconfException If the file cannot be opened or parsed.
+     */
+    static std::shared_ptr<const IncludedFile> parseIncluded(const std::string& path, bool inferTypes);
+
+    /**
+     * @brief Resolves an include path against the including file.
+     * @param from The path of the including file.
+     * @param path The path given in the directive.
+     * @return The normalized path of the included file.
+     */
+    static std::string resolveInclude(const std::string& from, const std::string& path);
+
+    /**
+     * @brief Merges an included file and, first, everything it includes.
+     * @param path The resolved path of the included file.
+     * @param chain The files being included, outermost first, used to
+     *        detect cycles.
+     * @throws SconfException If the file cannot be parsed or includes
+     *         itself, directly or indirectly.
+     */
+    void applyInclude(const std::string& path, std::vector<std::string>& chain);
+
+    /**
+     * @brief Merges a freshly parsed file, after the files it includes,
+     *        into this document.
+     *
+     * The includes are applied to a scratch document first, so this one
+     * is left untouched if any of them fails.
+     *
+     * @param loaded The file's own sections and comments.
+     * @param filename The path of the file.
+     * @param includes The resolved paths of the files it includes.
+     * @param options The options of the load.
+     * @throws SconfException If an included file cannot be parsed or
+     *         includes itself, or if interpolation fails.
+     */
+    void commitLoad(
+        const sConfParser& loaded,
+        const std::string& filename,
+        const std::vector<std::string>& includes,
+        const sConfLoadOptions& options
+    );
+
+    /**
+     * @brief Merges a loaded document into this one and, if asked,
+     *        interpolates the result.
+     *
+     * The merge and interpolation run on a structurally shared copy that
+     * replaces this document's contents only once both have succeeded,
+     * so a failure, such as an interpolation cycle, leaves it untouched.
+     *
+     * @param loaded The loaded document.
+     * @param options The options of the load.
+     * @throws SconfException If interpolation fails.
+     */
+    void mergeLoaded(const sConfParser& loaded, const sConfLoadOptions& options);
+
+    /**
+     * @brief Looks up a section by a caller-supplied name without throwing.
+     *
+     * Names are normalized into a view of the given string, and looked up
+     * as they are when they need no trimming. The tables are keyed by
+     * `std::string`, so a trimmed name is copied into a key first, which
+     * allocates only if it is too long for the small-string buffer.
+     *
+     * @param section The section name, as given to a public accessor.
+     * @param error Receives the reason if the section is not found.
+     * @return A pointer to the section, or `nullptr`.
+     */
+    const Section* lookupSection(const std::string& section, sConfError& error) const noexcept;
+
+    /**
+     * @brief Looks up a value by caller-supplied names without throwing.
+     * @param section The section name, as given to a public accessor.
+     * @param key The key, as given to a public accessor.
+     * @param error Receives the reason if the value is not found.
+     * @return A pointer to the value, or `nullptr`.
+     */
+    const sConfValue* lookupValue(
+        const std::string& section,
+        const std::string& key,
+        sConfError& error
+    ) const noexcept;
+
+    /**
+     * @brief Checks whether a section has comments, without counting a lookup.
+     * @param section The already-normalized section name.
+     * @return `true` if comments exist for the section, `false` otherwise.
+     */
+    bool sectionHasComments(const std::string& section) const;
+
+    /**
+     * @brief Retrieves a section for writing, creating it if needed.
+     *
+     * Clones the section table and the section node first if they are
+     * shared with another parser, and forgets the section's source hash.
+     *
+     * @param section The already-normalized section name.
+     * @return A reference to the privately owned section.
+     */
+    Section& mutableSection(const std::string& section);
+
+    /**
+     * @brief Retrieves a section node for writing, creating it if needed.
+     *
+     * Like mutableSection(), but also gives access to the node's source
+     * locations.
+     *
+     * @param section The already-normalized section name.
+     * @return A reference to the privately owned node.
+     */
+    SectionNode& mutableNode(const std::string& section);
+
+    /**
+     * @brief Retrieves the spans of a node for appending, cloning them
+     *        first if they are shared or already sorted.
+     * @param node A privately owned node.
+     * @return The spans.
+     */
+    static std::vector<KeySpan>& mutableSpans(SectionNode& node);
+
+    /**
+     * @brief Finds the span of a key, sorting the node's spans on first use.
+     *
+     * Safe to call concurrently on a shared, materialized node.
+     *
+     * @param node The section node.
+     * @param key The already-normalized key.
+     * @return The span, or `nullptr` if the key's location is unknown.
+     */
+    static const KeySpan* findSpan(const SectionNode& node, const std::string& key);
+
+    /**
+     * @brief Converts a packed position into a location.
+     * @param position The position.
+     * @param valueColumn The column of the value, or 0.
+     * @return The location, or nothing if the position is unknown.
+     */
+    static std::optional<sConfLocation> toLocation(const SourcePosition& position, std::uint32_t valueColumn);
+
+    /**
+     * @brief Describes where a key was loaded from, for error messages.
+     * @param section The already-normalized section name.
+     * @param key The already-normalized key.
+     * @return `file:line:column: `, or an empty string if unknown.
+     */
+    std::string where(const std::string& section, const std::string& key) const;
+
+    /**
+     * @brief Retrieves the section table for writing.
+     * @return A reference to the privately owned section table.
+     */
+    SectionTable& mutableData();
+
+    /**
+     * @brief Retrieves the comment table for writing.
+     * @return A reference to the privately owned comment table.
+     */
+    CommentTable& mutableComments();
+
+    /**
+     * @brief Retrieves the interpolation graph for writing, creating it if
+     *        interpolation has not been enabled yet.
+     * @return A reference to the privately owned graph.
+     */
+    sConfInterpolation& mutableInterpolation();
+
+    /**
+     * @brief Expanded values waiting to be stored, in expansion order.
+     */
+    using Expansion = std::vector<std::pair<sConfInterpolation::Key, sConfValue>>;
+
+    /**
+     * @brief Expands templates in dependency order without modifying the
+     *        document.
+     *
+     * References resolve to earlier entries of `updates` first and to the
+     * document otherwise, so each template is expanded exactly once.
+     *
+     * @param graph The graph holding the templates.
+     * @param order The templates to expand, as returned by the graph.
+     * @param updates Receives the expanded values; may already hold values
+     *        that references should see.
+     * @throws SconfException If a reference names a missing key or an unset
+     *         environment variable.
+     */
+    void expandTemplates(
+        const sConfInterpolation& graph,
+        const std::vector<sConfInterpolation::Key>& order,
+        Expansion& updates
+    ) const;
+
+    /**
+     * @brief Records a new value of a key in the interpolation graph and
+     *        expands the templates depending on it.
+     *
+     * The graph is restored if the expansion fails.
+     *
+     * @param section The already-normalized section name.
+     * @param key The already-normalized key name.
+     * @param value The new value.
+     * @return The values to store: the key's own, followed by its dependents.
+     * @throws SconfException If the expansion fails.
+     */
+    Expansion interpolateKey(const std::string& section, const std::string& key, const sConfValue& value);
+
+    /**
+     * @brief Stores a batch of values produced by interpolateKey() and
+     *        notifies the subscribers of the keys that changed.
+     * @param updates The values to store, in order.
+     */
+    void setKeys(Expansion updates);
+
+    /**
+     * @brief Checks whether a lazily loaded section may hold templates,
+     *        without parsing it.
+     * @param pending The section's unparsed source.
+     * @return `true` if any of the section's lines contains `${`.
+     */
+    static bool mayHoldTemplates(const PendingSection& pending);
+
+    /**
+     * @class SectionHashes
+     * @brief Accumulates a content hash per section from parser events.
+     *
+     * Comments are attributed to the section whose header follows them,
+     * matching how comments are stored. Whitespace, blank lines and inline
+     * comments do not contribute to the hash.
+     */
+    class SectionHashes : public sConfHandler {
+    public:
+        /**
+         * @brief Running hash of a section and whether this load created it.
+         *
+         * `hash` covers the section's content only, so a section moved
+         * within its file keeps its hash. Where its lines are is tracked
+         * apart: `line` is the first line of the section's content and
+         * `layout` hashes the offsets of its other lines from that one.
+         */
+        struct Entry {
+            std::uint64_t hash = 0;
+            std::uint64_t layout = 0;
+            std::uint32_t line = 0;
+            bool created = false;
+        };
+
+        /**
+         * @brief Constructs an accumulator.
+         * @param document The document being loaded into, used to tell
+         *        which sections the load creates, or `nullptr` if every
+         *        section is new.
+         */
+        explicit SectionHashes(const sConfParser* document) :
+            document(document) {}
+
+        /**
+         * @brief The event parser feeding this accumulator, whose line
+         *        numbers give each entry's `line` and `layout`.
+         */
+        const sConfEventParser* events = nullptr;
+
+        void onSection(const std::string& name) override;
+        void onComment(const std::string& text) override;
+        void onInclude(const std::string& path) override;
+        void onKey(const std::string& key, const std::string& rawValue) override;
+
+        /**
+         * @brief Hash entries keyed by section name.
+         */
+        std::unordered_map<std::string, Entry> entries;
+
+    private:
+        /**
+         * @brief Folds the pending comments and a line of content into
+         *        the current section's hash.
+         * @param text The canonical text of the line.
+         */
+        void content(const std::string& text);
+
+        /**
+         * @brief The document being loaded into, or `nullptr`.
+         */
+        const sConfParser* document;
+
+        /**
+         * @brief The section the following lines belong to.
+         */
+        std::string currentSection;
+
+        /**
+         * @brief Hashes of the comments awaiting the next section content.
+         */
+        std::vector<std::uint64_t> pendingComments;
+    };
+
+    /**
+     * @class Loader
+     * @brief Event handler storing parsed sections, keys and comments into
+     *        a document.
+     */
+    class Loader;
+
+    /**
+     * @brief Stores source hashes for sections created by a load.
+     * @param hashes The hashes accumulated during the load.
+     */
+    void adoptHashes(const SectionHashes& hashes);
+
+    /**
+     * @brief Moves the recorded source positions of a section by a number
+     *        of lines, for a section reused at another place in its file.
+     * @param node The section, which must not be shared with other
+     *        documents.
+     * @param delta The number of lines the section moved down by.
+     */
+    static void shiftLines(SectionNode& node, std::int64_t delta);
+
+    /**
+     * @brief Records the key-level differences between two versions of a section.
+     * @param diff The diff to append to.
+     * @param section The name of the section.
+     * @param before The old version, or `nullptr` if the section was added.
+     * @param after The new version, or `nullptr` if the section was removed.
+     * @return `true` if any key was added, removed or modified.
+     */
+    static bool diffSection(
+        sConfDiff& diff,
+        const std::string& section,
+        const Section* before,
+        const Section* after
+    );
 
     /**
      * @brief Removes leading and trailing whitespace from a string.
@@ -72,55 +706,176 @@ private:
     static std::string trimQuotes(const std::string& str);
 
     /**
-     * @brief Formats the parameter to yyyy-mm-dd HH:MM:SS
-     * @param time The std::tm variable to be converted.
-     * @return String-formatted date to yyyy-mm-dd HH:MM:SS.
+     * @brief Writes a single configuration value to an output file stream.
+     * @param file The output file stream.
+     * @param value The configuration value to save.
      */
-    static std::string formatDateTime(const std::tm& time);
+    static void saveValue(std::ofstream& file, const sConfValue& value);
 
+public:
     /**
-     * @brief Checks if a value represents an array.
-     * @param value The string value to check.
-     * @return `true` if the value represents an array, `false` otherwise.
+     * @brief Default sConfParser class constructor.
      */
-    static bool isArray(const std::string& value);
+    sConfParser() :
+        data(std::make_shared<SectionTable>()),
+        comments(std::make_shared<CommentTable>()),
+        interpolation(),
+        inferTypes(false),
+        subscriptions(),
+        statsRecorder() {}
 
     /**
-     * @brief Writes a single configuration value to an output file stream.
-     * @param file The output file stream.
-     * @param value The configuration value to save.
+     * @brief Loads a configuration file.
+     *
+     * A line `@include "path"` includes another file, resolved relative to
+     * the including file. Included files are parsed concurrently and
+     * applied before the including file's own content, in the order of
+     * their directives, so the including file always takes precedence.
+     *
+     * @param filename The path to the file to load.
+     * @throws std::runtime_error If the file or a file it includes cannot
+     *         be opened or parsed, or if files include each other in a cycle.
      */
-    static void saveValue(std::ofstream& file, const sConfValue& value);
+    void load(const std::string& filename);
 
     /**
-     * @brief Parses a string representing an array into individual sConfValues.
-     * @param value The string representing the array.
-     * @return A vector of sConfValue objects parsed from the array.
+     * @brief Loads a configuration file with the given options.
+     * @param filename The path to the file to load.
+     * @param options How to load the file.
+     * @throws std::runtime_error If the file cannot be opened or parsed.
      */
-    static std::vector<sConfValue> parseArray(const std::string& value);
+    void load(const std::string& filename, const sConfLoadOptions& options);
 
     /**
-     * @brief Parses a single line of the configuration file.
-     * @param line The line to be parsed.
-     * @param currentSection The current section being processed.
-     * @param commentBuffer A buffer for storing comments until associated with a section.
+     * @brief Loads a configuration file, collecting problems instead of
+     *        throwing.
+     *
+     * Malformed lines are skipped and every other line is loaded, so a
+     * single pass reports all problems of the file and leaves the valid
+     * part of it in the document. Reading stops once `options.maxErrors`
+     * problems were found. Included files that fail to load and failed
+     * interpolation are reported as well; `options.lazySections` is
+     * ignored, since every line must be parsed to be checked.
+     *
+     * @param filename The path to the file to load.
+     * @param options How to load the file.
+     * @return The problems found, in file order; empty if the whole file
+     *         was loaded.
      */
-    void parseLine(const std::string& line, std::string& currentSection, std::vector<std::string>& commentBuffer);
+    std::vector<sConfDiagnostic> tryLoad(
+        const std::string& filename,
+        const sConfLoadOptions& options = sConfLoadOptions()
+    );
 
-public:
     /**
-     * @brief Default sConfParser class constructor.
+     * @class Stream
+     * @brief Loads a document fed in chunks, such as from a pipe, a socket
+     *        or a decompressor. See the definition below.
      */
-    sConfParser() :
-        data({}),
-        comments({}) {}
+    class Stream;
 
     /**
-     * @brief Loads a configuration file.
+     * @brief Resolves `${section.key}` and `${ENV:VAR}` references.
+     *
+     * Every string value containing `${` becomes a template: its references
+     * are resolved once, in dependency order, and the expanded result is
+     * stored in its place, so reading it later costs nothing extra. A
+     * template consisting of one reference to a key takes that key's value
+     * and type; one consisting of one environment reference is typed like
+     * an unquoted value. Anything else becomes a string. `$${` stands for
+     * a literal `${`.
+     *
+     * The templates are kept, so save() writes them back unexpanded and
+     * setKey() re-expands only the values depending on the key it changes.
+     * Values depending on a removed key keep their last expansion. Calling
+     * it again registers only the values loaded or set since, and expands
+     * every template anew.
+     *
+     * @throws SconfException If references form a cycle, or name a missing
+     *         key or an unset environment variable; the document is left
+     *         unchanged.
+     */
+    void interpolate();
+
+    /**
+     * @brief Drops all included files cached by this process.
+     *
+     * Files included with `@include "path"` are parsed once per process
+     * and reused for as long as their inode, modification time and size
+     * stay the same; call this to release that memory. Parses still in
+     * flight, such as those started by a load that failed, are not waited
+     * for; they finish in the background.
+     */
+    static void clearIncludeCache();
+
+    /**
+     * @brief Loads several configuration files in parallel.
+     *
+     * Every file is parsed on a worker thread into a document of its own,
+     * then the documents are merged into this one in the order given, so
+     * later files take precedence exactly as if load() had been called on
+     * each file in turn.
+     *
+     * @param filenames The paths to the files to load, lowest precedence first.
+     * @param options How to load each file.
+     * @throws SconfException If any file cannot be opened or parsed, in
+     *         which case the document is left untouched. The error of the
+     *         first failing file in order is reported.
+     */
+    void loadAll(
+        const std::vector<std::string>& filenames,
+        const sConfLoadOptions& options = sConfLoadOptions()
+    );
+
+    /**
+     * @brief Loads all matching files of a directory in parallel.
+     *
+     * Matching files are loaded with loadAll() in byte-wise order of their
+     * names, so `10-base.sconf` is overridden by `20-site.sconf`.
+     *
+     * @param directory The directory to scan. Subdirectories are not entered.
+     * @param pattern Shell-style wildcard (`*`, `?`, `[...]`) the file
+     *        names must match.
+     * @param options How to load each file.
+     * @throws SconfException If the directory cannot be read or any file
+     *         cannot be opened or parsed.
+     */
+    void loadDirectory(
+        const std::string& directory,
+        const std::string& pattern = "*.sconf",
+        const sConfLoadOptions& options = sConfLoadOptions()
+    );
+
+    /**
+     * @brief Merges another document into this one.
+     *
+     * Keys of `other` replace keys of the same name, and its section
+     * comments are appended to the existing ones. Sections that only exist
+     * in `other` are shared with it rather than copied. Like load(), this
+     * does not notify subscribers.
+     *
+     * @param other The document to merge in.
+     */
+    void merge(const sConfParser& other);
+
+    /**
+     * @brief Replaces the document with the contents of a file, reusing
+     *        every section whose source text did not change.
+     *
+     * Each section's source lines are hashed, and sections whose hash
+     * matches the one recorded when they were last loaded are kept as-is
+     * without being parsed again, even if lines were added or removed
+     * before them; their locations are moved along. Only the changed
+     * sections are parsed.
+     * Sections modified in memory since they were loaded are always
+     * parsed again.
+     *
      * @param filename The path to the file to load.
-     * @throws std::runtime_error If the file cannot be opened or parsed.
+     * @return The sections and keys that were added, removed or modified.
+     * @throws std::runtime_error If the file cannot be opened or parsed,
+     *         in which case the document is left untouched.
      */
-    void load(const std::string& filename);
+    sConfDiff reload(const std::string& filename);
 
     /**
      * @brief Saves the current configuration to a file.
@@ -141,7 +896,7 @@ public:
      * @return A map of key-value pairs in the section.
      * @throws std::runtime_error If the section does not exist.
      */
-    std::unordered_map<std::string, sConfValue> getSection(const std::string& section) const;
+    Section getSection(const std::string& section) const;
 
     /**
      * @brief Adds a new section to the configuration.
@@ -152,6 +907,10 @@ public:
 
     /**
      * @brief Checks if a section exists.
+     *
+     * Answered from the section index, so a lazily loaded section is not
+     * parsed, and one that cannot be parsed still exists.
+     *
      * @param section The name of the section to check.
      * @return `true` if the section exists, `false` otherwise.
      */
@@ -166,10 +925,17 @@ public:
 
     /**
      * @brief Sets a key-value pair in a section.
+     *
+     * Once interpolate() has been called, a string value containing `${`
+     * is stored as a template and expanded, and every template that
+     * depends on the key, directly or transitively, is expanded again.
+     * Nothing is modified if an expansion fails.
+     *
      * @param section The name of the section.
      * @param key The key to set.
      * @param value The value to associate with the key.
-     * @throws std::runtime_error If the section does not exist.
+     * @throws std::runtime_error If the section does not exist, or if the
+     *         value cannot be interpolated.
      */
     void setKey(const std::string& section, const std::string& key, const sConfValue& value);
 
@@ -194,7 +960,7 @@ public:
      * @param section The name of the section.
      * @return A map of key-value pairs in the section.
      */
-    std::unordered_map<std::string, sConfValue> getSectionKeyPair(const std::string& section) const;
+    Section getSectionKeyPair(const std::string& section) const;
 
     /**
      * @brief Checks if a key's value in a section is an array.
@@ -212,6 +978,94 @@ public:
      */
     bool isSectionPairSingleString(const std::string& section, const std::string& key) const;
 
+    /**
+     * @brief Looks up a section without throwing or copying it.
+     * @param section The name of the section.
+     * @return A pointer to the section, or `nullptr` if it does not exist
+     *         or, if lazily loaded, cannot be parsed. The pointer stays
+     *         valid until the parser is modified or destroyed.
+     */
+    const Section* find(const std::string& section) const noexcept;
+
+    /**
+     * @brief Looks up a value without throwing or copying it.
+     * @param section The name of the section.
+     * @param key The key to look up.
+     * @return A pointer to the value, or `nullptr` if it does not exist.
+     *         The pointer stays valid until the parser is modified or
+     *         destroyed.
+     */
+    const sConfValue* find(const std::string& section, const std::string& key) const noexcept;
+
+    /**
+     * @brief Retrieves a typed value without throwing.
+     *
+     * A miss neither throws nor allocates, which makes this the cheap way
+     * to probe optional keys. A hit may throw `std::bad_alloc` only for
+     * the types that sConfValue::tryAs() copies.
+     *
+     * @tparam T The requested type, as accepted by sConfValue::tryAs().
+     * @param section The name of the section.
+     * @param key The key to retrieve.
+     * @return The value, or the reason it could not be retrieved:
+     *         `SectionNotFound`, `KeyNotFound`, `TypeMismatch` or
+     *         `InvalidSection`.
+     */
+    template<typename T>
+    sConfResult<T> tryGet(
+        const std::string& section,
+        const std::string& key
+    ) const noexcept(std::is_nothrow_copy_constructible_v<T>);
+
+    /**
+     * @brief Retrieves a typed value, or a fallback if it is missing or
+     *        of another type.
+     * @tparam T The requested type, as accepted by sConfValue::tryAs().
+     * @param section The name of the section.
+     * @param key The key to retrieve.
+     * @param fallback The value to return on failure.
+     * @return The value, or `fallback`.
+     */
+    template<typename T>
+    T getOr(
+        const std::string& section,
+        const std::string& key,
+        T fallback
+    ) const noexcept(std::is_nothrow_copy_constructible_v<T>);
+
+    /**
+     * @brief Retrieves a string value, or a fallback if it is missing or
+     *        not of type String, without copying either.
+     * @param section The name of the section.
+     * @param key The key to retrieve.
+     * @param fallback The string to return on failure; `nullptr` is
+     *        taken as an empty string.
+     * @return A view of the stored value, valid until the parser is
+     *         modified or destroyed, or of `fallback`.
+     */
+    std::string_view getOr(const std::string& section, const std::string& key, const char* fallback) const noexcept;
+
+    /**
+     * @brief Finds where a section was declared.
+     * @param section The name of the section.
+     * @return The location of the section's first header, or nothing if
+     *         the section does not exist or was not loaded from a file.
+     */
+    std::optional<sConfLocation> locate(const std::string& section) const;
+
+    /**
+     * @brief Finds where a key was loaded from.
+     *
+     * A key keeps the location it was last loaded from when setKey()
+     * changes its value in memory; keys added in memory have none.
+     *
+     * @param section The name of the section.
+     * @param key The key.
+     * @return The location of the key-value pair, or nothing if the key
+     *         does not exist or was not loaded from a file.
+     */
+    std::optional<sConfLocation> locate(const std::string& section, const std::string& key) const;
+
     /**
      * @brief Retrieves the comments associated with a section.
      * @param section The name of the section.
@@ -232,6 +1086,178 @@ public:
      * @throws std::runtime_error If the section does not exist.
      */
     void removeSectionComment(const std::string& section);
+
+    /**
+     * @brief Subscribes to changes of a single key.
+     *
+     * The callback fires after setKey(), removeSectionPairByKey(),
+     * removeSection() or reload() changes the key, receiving all changes of
+     * that operation that concern the key. Callbacks run synchronously on
+     * the thread performing the modification. load() does not notify
+     * subscribers; use reload() to pick up file changes with notifications.
+     *
+     * @param section The name of the section.
+     * @param key The key to watch.
+     * @param callback The callback to invoke.
+     * @return A handle for unsubscribe().
+     */
+    sConfSubscriptions::Id subscribe(
+        const std::string& section,
+        const std::string& key,
+        sConfSubscriptions::Callback callback
+    );
+
+    /**
+     * @brief Subscribes to changes of a section and any of its keys.
+     *
+     * The callback fires once per modifying operation, receiving both the
+     * section-level change and the changes of the section's keys.
+     *
+     * @param section The name of the section.
+     * @param callback The callback to invoke.
+     * @return A handle for unsubscribe().
+     */
+    sConfSubscriptions::Id subscribe(
+        const std::string& section,
+        sConfSubscriptions::Callback callback
+    );
+
+    /**
+     * @brief Removes a subscription.
+     * @param id The handle returned by subscribe().
+     * @return `true` if the subscription existed, `false` otherwise.
+     */
+    bool unsubscribe(sConfSubscriptions::Id id);
+
+    /**
+     * @brief Retrieves the parse, lookup and save counters of this parser.
+     *
+     * Counters are only collected when the library is built with
+     * `SCONF_ENABLE_STATS`; otherwise all counters are zero and
+     * `sConfStats::enabled` is `false`. Copies of a parser start with
+     * fresh counters.
+     *
+     * @return A snapshot of the counters.
+     */
+    sConfStats stats() const;
+
+    /**
+     * @brief Estimates the heap memory held by the document.
+     *
+     * Walks all sections and comments and attributes their storage to
+     * key strings, value strings, array storage, hash-table overhead and
+     * comments, per section and in total. Sections shared with copies of
+     * the parser are reported in full and flagged as shared. Lazily loaded
+     * sections that were never read are not parsed: they are reported
+     * with no keys and the size of their unparsed source text in
+     * `pendingBytes`.
+     *
+     * @return The memory usage breakdown.
+     */
+    sConfMemoryUsage memoryUsage() const;
+};
+
+/**
+ * @class sConfParser::Stream
+ * @brief Resumable loader parsing a document while it arrives in chunks.
+ *
+ * Each chunk given to feed() is parsed as far as its last complete line;
+ * only the incomplete line is kept for the next chunk, so reading and
+ * parsing overlap and memory stays proportional to the longest line.
+ * finish() parses that last line and applies the result to the target
+ * document like load() would, so the document never holds a partially
+ * fed input.
+ *
+ * @code
+ * sConfParser::Stream stream(parser, "network.conf");
+ * while((size = read(fd, buffer, sizeof(buffer))) > 0)
+ *     stream.feed(buffer, size);
+ * stream.finish();
+ * @endcode
+ */
+class sConfParser::Stream {
+public:
+    /**
+     * @brief Starts loading into a document.
+     * @param document The document to load into. Must outlive the stream.
+     * @param name The name of the input, used in errors and locations
+     *        and to resolve `@include` directives, which are rejected if
+     *        the name is empty.
+     * @param options How to load the input; `lazySections` is ignored.
+     */
+    explicit Stream(
+        sConfParser& document,
+        const std::string& name = "",
+        const sConfLoadOptions& options = sConfLoadOptions()
+    );
+
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+
+    /**
+     * @brief Destroys the stream; an unfinished input is discarded.
+     */
+    ~Stream();
+
+    /**
+     * @brief Parses the next chunk of the input.
+     * @param data The bytes of the chunk.
+     * @param size The number of bytes.
+     * @throws SconfException If a line is not valid sConf syntax, an
+     *         included file cannot be loaded, or finish() was called.
+     */
+    void feed(const char* data, std::size_t size);
+
+    /**
+     * @brief Parses the rest of the input and stores it in the document.
+     * @throws SconfException If the last line is not valid sConf syntax,
+     *         an included file or an interpolation fails, or finish() was
+     *         already called.
+     */
+    void finish();
+
+private:
+    /**
+     * @brief The document being built and the parsers feeding it.
+     */
+    struct State;
+
+    /**
+     * @brief The target document.
+     */
+    sConfParser& document;
+
+    /**
+     * @brief The load options.
+     */
+    sConfLoadOptions options;
+
+    /**
+     * @brief The parsing state, or `nullptr` once finished.
+     */
+    std::unique_ptr<State> state;
 };
 
+template<typename T>
+sConfResult<T> sConfParser::tryGet(
+    const std::string& section,
+    const std::string& key
+) const noexcept(std::is_nothrow_copy_constructible_v<T>) {
+    sConfError error = sConfError::None;
+    const sConfValue* value = this->lookupValue(section, key, error);
+    if(!value)
+        return error;
+
+    return value->tryAs<T>();
+}
+
+template<typename T>
+T sConfParser::getOr(
+    const std::string& section,
+    const std::string& key,
+    T fallback
+) const noexcept(std::is_nothrow_copy_constructible_v<T>) {
+    return this->tryGet<T>(section, key).valueOr(std::move(fallback));
+}
+
 #endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_result.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file defining sConfResult, the return type of the
+ *        non-throwing query functions.
+ */
+#ifndef SCONF_RESULT_HPP
+#define SCONF_RESULT_HPP
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @enum sConfError
+ * @brief Enumerates the reasons a non-throwing query can fail.
+ */
+enum class sConfError {
+    None,            ///< The query succeeded.
+    SectionNotFound, ///< The section does not exist.
+    KeyNotFound,     ///< The section exists but does not hold the key.
+    TypeMismatch,    ///< The value is not of the requested type.
+    OutOfRange,      ///< The value does not fit in the requested type.
+    InvalidSection   ///< A lazily loaded section could not be parsed.
+};
+
+/**
+ * @brief Describes an error code.
+ * @param error The error code.
+ * @return A static, human-readable description; never allocates.
+ */
+inline const char* sConfErrorMessage(sConfError error) noexcept {
+    switch(error) {
+        case sConfError::None:            return "No error";
+        case sConfError::SectionNotFound: return "Section not found";
+        case sConfError::KeyNotFound:     return "Key not found";
+        case sConfError::TypeMismatch:    return "Value is not of the requested type";
+        case sConfError::OutOfRange:      return "Value is out of range of the requested type";
+        case sConfError::InvalidSection:  return "Section could not be parsed";
+    }
+
+    return "Unknown error";
+}
+
+/**
+ * @class sConfResult
+ * @brief Either a value or the error code explaining its absence.
+ *
+ * A failed result holds nothing but the code, so building one never
+ * allocates.
+ *
+ * @tparam T The type of the value.
+ */
+template<typename T>
+class sConfResult {
+public:
+    /**
+     * @brief Constructs a successful result.
+     * @param value The value.
+     */
+    sConfResult(T value) noexcept :
+        result(std::move(value)),
+        code(sConfError::None) {}
+
+    /**
+     * @brief Constructs a failed result.
+     * @param error The reason of the failure; must not be `None`.
+     */
+    sConfResult(sConfError error) noexcept :
+        result(),
+        code(error) {}
+
+    /**
+     * @brief Checks whether the result holds a value.
+     * @return `true` on success, `false` otherwise.
+     */
+    bool hasValue() const noexcept {
+        return this->result.has_value();
+    }
+
+    /**
+     * @brief Checks whether the result holds a value.
+     * @return `true` on success, `false` otherwise.
+     */
+    explicit operator bool() const noexcept {
+        return this->hasValue();
+    }
+
+    /**
+     * @brief Accesses the value; the result must hold one.
+     * @return The value.
+     */
+    const T& operator*() const noexcept {
+        return *this->result;
+    }
+
+    /**
+     * @brief Accesses a member of the value; the result must hold one.
+     * @return A pointer to the value.
+     */
+    const T* operator->() const noexcept {
+        return &*this->result;
+    }
+
+    /**
+     * @brief Retrieves the value or a fallback.
+     * @param fallback The value to return on failure.
+     * @return The value on success, `fallback` otherwise.
+     */
+    T valueOr(T fallback) const noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return this->result ? *this->result : std::move(fallback);
+    }
+
+    /**
+     * @brief Retrieves the error code.
+     * @return The reason of the failure, or `sConfError::None` on success.
+     */
+    sConfError error() const noexcept {
+        return this->code;
+    }
+
+    /**
+     * @brief Retrieves the value as an optional, dropping the error code.
+     * @return The optional value.
+     */
+    const std::optional<T>& asOptional() const noexcept {
+        return this->result;
+    }
+
+private:
+    /**
+     * @brief The value, if the query succeeded.
+     */
+    std::optional<T> result;
+
+    /**
+     * @brief The reason of the failure, or `sConfError::None`.
+     */
+    sConfError code;
+};
+
+#endif
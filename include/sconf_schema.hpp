@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_schema.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfSchema class, which validates documents
+ *        against declared section and key rules.
+ */
+#ifndef SCONF_SCHEMA_HPP
+#define SCONF_SCHEMA_HPP
+
+#include <cstddef>
+#include <optional>
+#include <sconf_parser.hpp>
+#include <sconf_value.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct sConfKeyRule
+ * @brief The constraints a schema places on a single key.
+ *
+ * Unset constraints are not checked. Ranges and patterns apply to scalar
+ * values and, for arrays, to each element.
+ */
+struct sConfKeyRule {
+    /**
+     * @brief The required type, or any type if unset.
+     */
+    std::optional<sConfValue::Type> type;
+
+    /**
+     * @brief Whether the key must be present.
+     */
+    bool required = false;
+
+    /**
+     * @brief Smallest allowed number; non-numeric values are not checked.
+     */
+    std::optional<double> min;
+
+    /**
+     * @brief Largest allowed number; non-numeric values are not checked.
+     */
+    std::optional<double> max;
+
+    /**
+     * @brief Smallest allowed string length or array size.
+     */
+    std::optional<std::size_t> minLength;
+
+    /**
+     * @brief Largest allowed string length or array size.
+     */
+    std::optional<std::size_t> maxLength;
+
+    /**
+     * @brief Shell-style wildcard (`*`, `?`, `[...]`) that string values
+     *        must match in full, or empty for none.
+     */
+    std::string pattern;
+
+    /**
+     * @brief The required type of array elements, or any type if unset.
+     */
+    std::optional<sConfValue::Type> elementType;
+};
+
+/**
+ * @struct sConfSchemaError
+ * @brief A single rule violation found by sConfSchema.
+ */
+struct sConfSchemaError {
+    /**
+     * @brief The 1-based line of the offending key, or of its section
+     *        header for a missing key; 0 if unknown.
+     */
+    std::size_t line;
+
+    /**
+     * @brief The section of the offending key.
+     */
+    std::string section;
+
+    /**
+     * @brief The offending key.
+     */
+    std::string key;
+
+    /**
+     * @brief Describes the violation.
+     */
+    std::string message;
+};
+
+/**
+ * @class sConfSchema
+ * @brief A set of key rules compiled into a flat validation program.
+ *
+ * Each rule is translated into a run of simple checks stored back to back
+ * in one array, and keys are indexed by section and name, so validation
+ * visits every key once, runs only the checks of its rule and reports
+ * every violation rather than stopping at the first.
+ *
+ * Rules are declared in C++ with addKey() or read from a schema file with
+ * load(), in which every key of every section holds a space-separated
+ * rule, for example:
+ *
+ * @code
+ * [server]
+ * port = integer required min=1 max=65535
+ * host = string pattern=*.example.com length=1..253
+ * ids  = array items=integer length=..16 min=0
+ * @endcode
+ *
+ * Rule words are a type (`string`, `integer`, `double`, `boolean`,
+ * `date`, `array`, `duration`, `size` or `any`), `required` or `optional`, `min=N`, `max=N`,
+ * `length=N`, `length=A..B` (either bound may be omitted),
+ * `pattern=GLOB` and `items=TYPE`.
+ */
+class sConfSchema {
+public:
+    /**
+     * @brief Constructs an empty schema.
+     */
+    sConfSchema() :
+        program(),
+        rules(),
+        patterns(),
+        index() {}
+
+    /**
+     * @brief Declares the rule of a key, replacing any earlier rule.
+     * @param section The name of the section.
+     * @param key The key.
+     * @param rule The constraints on the key.
+     */
+    void addKey(const std::string& section, const std::string& key, const sConfKeyRule& rule);
+
+    /**
+     * @brief Declares the rules of a schema file.
+     * @param filename The path to the schema file.
+     * @throws SconfException If the file cannot be loaded or holds an
+     *         invalid rule.
+     */
+    void load(const std::string& filename);
+
+    /**
+     * @brief Validates a loaded document.
+     *
+     * Only sections and keys the schema declares are visited. Lines are
+     * taken from sConfParser::locate() and reported as 0 for keys that
+     * were not loaded from a file.
+     *
+     * @param document The document to validate.
+     * @return All violations found, or an empty vector if it is valid.
+     */
+    std::vector<sConfSchemaError> validate(const sConfParser& document) const;
+
+    /**
+     * @brief Validates a file while streaming through it, without building
+     *        a document.
+     *
+     * Reports the line of every violation. Include directives are not
+     * followed, and when a key appears twice each occurrence is checked.
+     *
+     * @param filename The path to the file to validate.
+     * @return All violations found, or an empty vector if it is valid.
+     * @throws SconfException If the file cannot be opened or is not valid
+     *         sConf syntax.
+     */
+    std::vector<sConfSchemaError> validateFile(const std::string& filename) const;
+
+    /**
+     * @brief Retrieves the name of a value type as used in schema files.
+     * @param type The type.
+     * @return The lowercase type name.
+     */
+    static const char* typeName(sConfValue::Type type);
+
+private:
+    /**
+     * @enum Opcode
+     * @brief The operations of the validation program.
+     */
+    enum class Opcode : unsigned char {
+        Type,        ///< The value has type `type`.
+        ElementType, ///< Every array element has type `type`.
+        Min,         ///< Numbers are at least `number`.
+        Max,         ///< Numbers are at most `number`.
+        MinLength,   ///< The string or array length is at least `length`.
+        MaxLength,   ///< The string or array length is at most `length`.
+        Pattern      ///< Strings match `patterns[length]`.
+    };
+
+    /**
+     * @struct Check
+     * @brief One instruction of the validation program.
+     */
+    struct Check {
+        Opcode opcode;
+        sConfValue::Type type;
+        double number;
+        std::size_t length;
+    };
+
+    /**
+     * @struct Rule
+     * @brief A compiled key rule: a run of checks in `program`.
+     */
+    struct Rule {
+        std::string section;
+        std::string key;
+        bool required;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /**
+     * @class Validator
+     * @brief Event handler validating a file as it is parsed.
+     */
+    class Validator;
+
+    /**
+     * @class Reader
+     * @brief Event handler declaring the rules of a schema file.
+     */
+    class Reader;
+
+    /**
+     * @brief Runs the checks of a rule against a value.
+     * @param rule The rule.
+     * @param value The value.
+     * @param line The line of the value, or 0.
+     * @param errors Receives the violations.
+     */
+    void run(
+        const Rule& rule,
+        const sConfValue& value,
+        std::size_t line,
+        std::vector<sConfSchemaError>& errors
+    ) const;
+
+    /**
+     * @brief Runs one scalar check against a value or array element.
+     * @param check The check.
+     * @param value The scalar value.
+     * @param message Receives the violation if the check fails.
+     * @return `true` if the check passes, `false` otherwise.
+     */
+    bool runScalar(const Check& check, const sConfValue& value, std::string& message) const;
+
+    /**
+     * @brief Reports the required keys that were not seen.
+     * @param seen Whether each rule's key was seen, by rule index.
+     * @param sectionLines The header line of each seen section.
+     * @param errors Receives the violations.
+     */
+    void reportMissing(
+        const std::vector<char>& seen,
+        const std::unordered_map<std::string, std::size_t>& sectionLines,
+        std::vector<sConfSchemaError>& errors
+    ) const;
+
+    /**
+     * @brief Parses a rule written in the schema file syntax.
+     * @param text The rule text.
+     * @return The rule.
+     * @throws SconfException If a word is not understood.
+     */
+    static sConfKeyRule parseRule(const std::string& text);
+
+    /**
+     * @brief The checks of all rules, each rule's checks stored together.
+     */
+    std::vector<Check> program;
+
+    /**
+     * @brief The compiled rules.
+     */
+    std::vector<Rule> rules;
+
+    /**
+     * @brief The patterns referred to by `Pattern` checks.
+     */
+    std::vector<std::string> patterns;
+
+    /**
+     * @brief Rule index of every declared key, by section and key.
+     */
+    std::unordered_map<std::string, std::unordered_map<std::string, std::size_t>> index;
+};
+
+#endif
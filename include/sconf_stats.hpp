@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_stats.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the optional parse and lookup instrumentation
+ *        of sConfParser.
+ *
+ * Instrumentation is compiled in only when `SCONF_ENABLE_STATS` is defined
+ * (the `SCONF_ENABLE_STATS` CMake option, which the sconf targets export to
+ * their users). Otherwise every recording call is an empty inline function
+ * and `sConfParser::stats()` reports zeros. Code using the library must be
+ * compiled with the same setting as the library itself.
+ */
+#ifndef SCONF_STATS_HPP
+#define SCONF_STATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @struct sConfStats
+ * @brief Snapshot of the counters collected by an sConfParser.
+ */
+struct sConfStats {
+    /**
+     * @enum Phase
+     * @brief Phases of loading a document.
+     */
+    enum Phase {
+        Scan,     ///< Reading lines and classifying them.
+        Tokenize, ///< Splitting lines into keys, values and comments.
+        Decode,   ///< Building sConfValue objects from value text.
+        Insert,   ///< Storing values and comments in the document.
+        PhaseCount
+    };
+
+    /**
+     * @enum Accessor
+     * @brief Lookup methods whose use is counted.
+     */
+    enum Accessor {
+        GetSection,
+        HasSection,
+        GetSectionKeyPair,
+        HasSectionPairByKey,
+        IsSectionPairArray,
+        IsSectionPairSingleString,
+        GetSectionComment,
+        HasSectionComment,
+        Find,
+        TryGet,
+        AccessorCount
+    };
+
+    /**
+     * @brief Whether the counters were compiled in.
+     */
+    bool enabled = false;
+
+    /**
+     * @brief Bytes read by load() and reload(), including line terminators.
+     */
+    std::uint64_t bytesParsed = 0;
+
+    /**
+     * @brief Lines read by load() and reload().
+     */
+    std::uint64_t linesParsed = 0;
+
+    /**
+     * @brief Time spent in each load phase, in nanoseconds.
+     */
+    std::uint64_t phaseNanoseconds[PhaseCount] = {};
+
+    /**
+     * @brief Estimated heap allocations made while inserting parsed data.
+     *
+     * Derived from the inserted keys and values (one node per key, plus
+     * one buffer per string too long for the small-string optimization and
+     * per array) rather than from the allocator itself.
+     */
+    std::uint64_t allocations = 0;
+
+    /**
+     * @brief Estimated heap bytes requested while inserting parsed data.
+     */
+    std::uint64_t allocatedBytes = 0;
+
+    /**
+     * @brief Number of calls to each accessor.
+     */
+    std::uint64_t lookups[AccessorCount] = {};
+
+    /**
+     * @brief Number of calls to each accessor that did not find their target.
+     */
+    std::uint64_t misses[AccessorCount] = {};
+
+    /**
+     * @brief Number of completed save() calls.
+     */
+    std::uint64_t saves = 0;
+
+    /**
+     * @brief Time spent in save(), in nanoseconds.
+     */
+    std::uint64_t saveNanoseconds = 0;
+
+    /**
+     * @brief Computes the miss rate of an accessor.
+     * @param accessor The accessor.
+     * @return The fraction of calls that missed, or 0 if never called.
+     */
+    double missRate(Accessor accessor) const;
+
+    /**
+     * @brief Retrieves the name of a load phase.
+     * @param phase The phase.
+     * @return The phase name, e.g. `"scan"`.
+     */
+    static const char* phaseName(Phase phase);
+
+    /**
+     * @brief Retrieves the name of an accessor.
+     * @param accessor The accessor.
+     * @return The accessor's method name, e.g. `"getSection"`.
+     */
+    static const char* accessorName(Accessor accessor);
+
+    /**
+     * @brief Formats the counters in the Prometheus text exposition format.
+     * @param prefix The metric name prefix.
+     * @return The metrics, one sample per line.
+     */
+    std::string toPrometheus(const std::string& prefix = "sconf") const;
+};
+
+/**
+ * @class sConfStatsRecorder
+ * @brief Thread-safe counters updated by sConfParser.
+ *
+ * Counters use relaxed atomics so that const accessors can record from
+ * several threads. A copied recorder starts from zero, so the counters
+ * describe the work done through one parser object.
+ *
+ * With `SCONF_ENABLE_STATS` defined the constructor and the recording
+ * calls are defined in the library; without it they are empty inline
+ * functions, so a disabled build pays nothing for them. The counters live
+ * behind a pointer that is only allocated when instrumentation is
+ * compiled in.
+ */
+class sConfStatsRecorder {
+public:
+    /**
+     * @brief Timestamp used to measure phases.
+     */
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+#ifdef SCONF_ENABLE_STATS
+    /**
+     * @brief Constructs a recorder with zeroed counters.
+     */
+    sConfStatsRecorder();
+#else
+    sConfStatsRecorder() :
+        counters() {}
+#endif
+
+    sConfStatsRecorder(const sConfStatsRecorder&) :
+        sConfStatsRecorder() {}
+
+    sConfStatsRecorder& operator=(const sConfStatsRecorder&) {
+        return *this;
+    }
+
+#ifdef SCONF_ENABLE_STATS
+    /**
+     * @brief Takes a timestamp.
+     * @return The current time.
+     */
+    static TimePoint now();
+
+    /**
+     * @brief Adds the time elapsed since a timestamp to a phase.
+     * @param phase The phase to charge.
+     * @param since The start of the measured interval.
+     * @return The end of the measured interval, to chain measurements.
+     */
+    TimePoint lap(sConfStats::Phase phase, TimePoint since) const;
+
+    /**
+     * @brief Records a line read from a file.
+     * @param bytes The length of the line including its terminator.
+     */
+    void line(std::size_t bytes) const;
+
+    /**
+     * @brief Records an estimated heap allocation.
+     * @param bytes The size of the allocation.
+     */
+    void allocation(std::size_t bytes) const;
+
+    /**
+     * @brief Records a call to an accessor.
+     * @param accessor The accessor called.
+     * @param hit Whether the accessor found its target.
+     */
+    void lookup(sConfStats::Accessor accessor, bool hit) const;
+
+    /**
+     * @brief Records a completed save.
+     * @param since The time the save started.
+     */
+    void save(TimePoint since) const;
+
+    /**
+     * @brief Adds the parse counters of another recorder to this one.
+     * @param other The recorder whose parse work to take over.
+     */
+    void absorb(const sConfStatsRecorder& other) const;
+#else
+    static TimePoint now() {
+        return {};
+    }
+
+    TimePoint lap(sConfStats::Phase, TimePoint) const {
+        return {};
+    }
+
+    void line(std::size_t) const {}
+    void allocation(std::size_t) const {}
+    void lookup(sConfStats::Accessor, bool) const {}
+    void save(TimePoint) const {}
+    void absorb(const sConfStatsRecorder&) const {}
+#endif
+
+    /**
+     * @brief Reads all counters.
+     * @return A snapshot of the counters; all zeros, with
+     *         `sConfStats::enabled` unset, if this recorder has none.
+     */
+    sConfStats snapshot() const;
+
+private:
+    /**
+     * @brief The counters themselves, allocated only when instrumentation
+     *        is compiled in.
+     */
+    struct Counters {
+        std::atomic<std::uint64_t> bytesParsed{0};
+        std::atomic<std::uint64_t> linesParsed{0};
+        std::atomic<std::uint64_t> phaseNanoseconds[sConfStats::PhaseCount] = {};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> allocatedBytes{0};
+        std::atomic<std::uint64_t> lookups[sConfStats::AccessorCount] = {};
+        std::atomic<std::uint64_t> misses[sConfStats::AccessorCount] = {};
+        std::atomic<std::uint64_t> saves{0};
+        std::atomic<std::uint64_t> saveNanoseconds{0};
+    };
+
+    /**
+     * @brief The counters, or null if instrumentation is compiled out.
+     */
+    std::unique_ptr<Counters> counters;
+};
+
+#endif
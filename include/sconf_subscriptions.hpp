@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_subscriptions.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfSubscriptions class, an index of
+ *        change callbacks keyed by section and key.
+ */
+#ifndef SCONF_SUBSCRIPTIONS_HPP
+#define SCONF_SUBSCRIPTIONS_HPP
+
+#include <cstdint>
+#include <functional>
+#include <sconf_diff.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class sConfSubscriptions
+ * @brief Indexed registry of change callbacks.
+ *
+ * Subscribers are indexed by section and then by key, so dispatching a
+ * batch of changes only visits the subscribers of the affected sections
+ * and keys. Each subscriber is invoked at most once per batch, with the
+ * subset of changes it subscribed to.
+ *
+ * Subscriptions belong to one document object and are never transferred:
+ * copying or moving a registry yields an empty one, and copy or move
+ * assigning to a registry keeps its own subscribers. The source of a move
+ * keeps its subscribers as well, so callbacks that capture the original
+ * object never fire on behalf of another one.
+ */
+class sConfSubscriptions {
+public:
+    /**
+     * @brief Callback receiving the batch of changes relevant to a subscriber.
+     */
+    using Callback = std::function<void(const std::vector<sConfChange>&)>;
+
+    /**
+     * @brief Handle identifying a subscription.
+     */
+    using Id = std::uint64_t;
+
+    /**
+     * @brief Constructs an empty registry.
+     */
+    sConfSubscriptions() :
+        index({}),
+        owners({}),
+        nextId(1) {}
+
+    /**
+     * @brief Constructs an empty registry; subscribers are not copied.
+     */
+    sConfSubscriptions(const sConfSubscriptions&) :
+        sConfSubscriptions() {}
+
+    /**
+     * @brief Keeps the current subscribers; subscribers are not copied.
+     * @return A reference to this registry.
+     */
+    sConfSubscriptions& operator=(const sConfSubscriptions&) {
+        return *this;
+    }
+
+    /**
+     * @brief Constructs an empty registry; subscribers are not moved.
+     */
+    sConfSubscriptions(sConfSubscriptions&&) noexcept :
+        sConfSubscriptions() {}
+
+    /**
+     * @brief Keeps the current subscribers; subscribers are not moved.
+     * @return A reference to this registry.
+     */
+    sConfSubscriptions& operator=(sConfSubscriptions&&) noexcept {
+        return *this;
+    }
+
+    /**
+     * @brief Subscribes to changes of a single key.
+     * @param section The normalized section name.
+     * @param key The normalized key.
+     * @param callback The callback to invoke.
+     * @return The subscription handle.
+     */
+    Id subscribe(const std::string& section, const std::string& key, Callback callback);
+
+    /**
+     * @brief Subscribes to changes of a section and any of its keys.
+     * @param section The normalized section name.
+     * @param callback The callback to invoke.
+     * @return The subscription handle.
+     */
+    Id subscribe(const std::string& section, Callback callback);
+
+    /**
+     * @brief Removes a subscription.
+     * @param id The subscription handle.
+     * @return `true` if the subscription existed, `false` otherwise.
+     */
+    bool unsubscribe(Id id);
+
+    /**
+     * @brief Checks whether anyone subscribed to a section or its keys.
+     * @param section The normalized section name.
+     * @return `true` if the section has subscribers.
+     */
+    bool isWatched(const std::string& section) const;
+
+    /**
+     * @brief Checks whether the registry has no subscribers at all.
+     * @return `true` if there are no subscribers.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Delivers a batch of changes to the affected subscribers.
+     * @param changes The changes, each naming a section and optionally a key.
+     */
+    void dispatch(const std::vector<sConfChange>& changes) const;
+
+    /**
+     * @brief Delivers all changes of a diff as one batch.
+     * @param diff The diff to deliver.
+     */
+    void dispatch(const sConfDiff& diff) const;
+
+private:
+    /**
+     * @brief A registered callback and its handle.
+     */
+    struct Subscriber {
+        Id id;
+        Callback callback;
+    };
+
+    /**
+     * @brief Subscribers of one section.
+     */
+    struct SectionEntry {
+        /**
+         * @brief Subscribers to the whole section.
+         */
+        std::vector<Subscriber> sectionWide;
+
+        /**
+         * @brief Subscribers to individual keys.
+         */
+        std::unordered_map<std::string, std::vector<Subscriber>> keys;
+    };
+
+    /**
+     * @brief Where a subscription is registered in the index.
+     */
+    struct Owner {
+        std::string section;
+        std::string key;
+        bool sectionWide;
+    };
+
+    /**
+     * @brief Subscribers indexed by section, then key.
+     */
+    std::unordered_map<std::string, SectionEntry> index;
+
+    /**
+     * @brief Index location of each subscription, for removal.
+     */
+    std::unordered_map<Id, Owner> owners;
+
+    /**
+     * @brief The handle given to the next subscription.
+     */
+    Id nextId;
+};
+
+#endif
@@ -25,9 +25,17 @@
 #ifndef SCONF_VALUE_HPP
 #define SCONF_VALUE_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <ctime>
 #include <iomanip>
+#include <limits>
+#include <sconf_result.hpp>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 /**
@@ -45,21 +53,32 @@ public:
      * @brief Enumerates the supported data types for a configuration value.
      */
     enum class Type {
-        String,  ///< A string value.
-        Integer, ///< An integer value.
-        Double,  ///< A double-precision floating-point value.
-        Boolean, ///< A boolean value.
-        Date,    ///< A date and time value.
-        Array    ///< An array of sConfValue objects.
+        String,   ///< A string value.
+        Integer,  ///< An integer value.
+        Double,   ///< A double-precision floating-point value.
+        Boolean,  ///< A boolean value.
+        Date,     ///< A date and time value.
+        Array,    ///< An array of sConfValue objects.
+        Duration, ///< A span of time such as `250ms` or `1h30m`.
+        Size      ///< A number of bytes such as `512B`, `10kB` or `64MiB`.
     };
 
+    /**
+     * @brief A date and time with one-second resolution, counted in UTC
+     *        from the Unix epoch; the same type as C++20's
+     *        `std::chrono::sys_seconds`.
+     */
+    using TimePoint = std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>;
+
     /**
      * @brief Default constructor. Initializes the value as an empty string.
      */
     sConfValue() :
         stringValue(""),
         values({}),
-        type(Type::String) {}
+        type(Type::String),
+        scalar(),
+        state(State::Decoded) {}
 
     /**
      * @brief Constructs a sConfValue with a string value.
@@ -68,7 +87,9 @@ public:
     explicit sConfValue(const std::string& val) :
         stringValue(val),
         values({}),
-        type(Type::String) {}
+        type(Type::String),
+        scalar(),
+        state(State::Decoded) {}
 
     /**
      * @brief Constructs a sConfValue with an integer value.
@@ -77,7 +98,40 @@ public:
     explicit sConfValue(int val) :
         stringValue(std::to_string(val)),
         values({}),
-        type(Type::Integer) {}
+        type(Type::Integer),
+        scalar(),
+        state(State::Decoded) {
+        this->scalar.integer = val;
+    }
+
+    /**
+     * @brief Constructs a sConfValue with a 64-bit integer value.
+     * @param val The integer value to set.
+     */
+    explicit sConfValue(std::int64_t val) :
+        stringValue(std::to_string(val)),
+        values({}),
+        type(Type::Integer),
+        scalar(),
+        state(State::Decoded) {
+        this->scalar.integer = val;
+    }
+
+    /**
+     * @brief Constructs a sConfValue with an unsigned 64-bit integer value.
+     * @param val The integer value to set.
+     */
+    explicit sConfValue(std::uint64_t val) :
+        stringValue(std::to_string(val)),
+        values({}),
+        type(Type::Integer),
+        scalar(),
+        state(State::Decoded) {
+        this->aboveInt64 = val > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+        if(this->aboveInt64)
+            this->scalar.unsignedInteger = val;
+        else this->scalar.integer = static_cast<std::int64_t>(val);
+    }
 
     /**
      * @brief Constructs a sConfValue with a double value.
@@ -86,7 +140,11 @@ public:
     explicit sConfValue(double val) :
         stringValue(std::to_string(val)),
         values({}),
-        type(Type::Double) {}
+        type(Type::Double),
+        scalar(),
+        state(State::Decoded) {
+        this->scalar.real = val;
+    }
 
     /**
      * @brief Constructs a sConfValue with a boolean value.
@@ -95,7 +153,11 @@ public:
     explicit sConfValue(bool val) :
         stringValue(val ? "true" : "false"),
         values({}),
-        type(Type::Boolean) {}
+        type(Type::Boolean),
+        scalar(),
+        state(State::Decoded) {
+        this->scalar.boolean = val;
+    }
 
     /**
      * @brief Constructs a sConfValue with an array of sConfValue objects.
@@ -104,33 +166,123 @@ public:
     explicit sConfValue(const std::vector<sConfValue>& val) :
         stringValue(""),
         values(val),
-        type(Type::Array) {}
+        type(Type::Array),
+        scalar(),
+        state(State::Decoded) {}
 
     /**
      * @brief Constructs a sConfValue with a date value.
+     *
+     * Out-of-range fields are normalized, so the 32nd of January is the
+     * 1st of February. The text is `yyyy-MM-dd hh:mm:ss`.
+     *
      * @param val The date and time value to set.
      */
-    explicit sConfValue(const std::tm& val) :
-        stringValue(""),
-        values({}),
-        type(Type::Date) {
-        char buffer[32];
-        std::strftime(
-            buffer,
-            sizeof(buffer),
-            "%Y-%m-%d %H:%M:%S",
-            &val
-        );
-
-        stringValue = buffer;
-    }
+    explicit sConfValue(const std::tm& val);
+
+    /**
+     * @brief Constructs a sConfValue with a date value.
+     * @param val The date and time value to set.
+     */
+    explicit sConfValue(TimePoint val);
+
+    /**
+     * @brief Constructs a sConfValue with a duration value.
+     *
+     * The text is the canonical form, largest unit first, such as `1m30s`.
+     *
+     * @param val The duration to set.
+     */
+    explicit sConfValue(std::chrono::nanoseconds val);
+
+    /**
+     * @brief Creates a byte-size value.
+     *
+     * The text is the canonical form, using the largest unit that divides
+     * the size exactly, such as `64MiB`.
+     *
+     * @param bytes The number of bytes.
+     * @return The value.
+     */
+    static sConfValue fromSize(std::uint64_t bytes);
+
+    /**
+     * @brief Copy constructor.
+     *
+     * Safe to call while other threads read, and possibly decode, `other`.
+     *
+     * @param other The value to copy.
+     */
+    sConfValue(const sConfValue& other);
+
+    /**
+     * @brief Move constructor.
+     * @param other The value to move from.
+     */
+    sConfValue(sConfValue&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other The value to copy.
+     * @return A reference to this value.
+     */
+    sConfValue& operator=(const sConfValue& other);
+
+    /**
+     * @brief Move assignment operator.
+     * @param other The value to move from.
+     * @return A reference to this value.
+     */
+    sConfValue& operator=(sConfValue&& other) noexcept;
+
+    /**
+     * @brief Creates a value from configuration text, inferring its type.
+     *
+     * The text is only stored; its type is detected and the typed value
+     * decoded on the first call to any getter, and cached from then on.
+     * Decoding is thread-safe, so a shared value may be read concurrently.
+     *
+     * Quoted text is a string. Unquoted text is a boolean (`true` or
+     * `false`), an integer, a double, a date (`yyyy-mm-dd` with optional
+     * `hh:mm:ss`), a duration (`250ms`, `1h30m`), a byte size (`64MiB`,
+     * `10kB`) or a bracketed, comma-separated array, and a string
+     * otherwise. Since unit suffixes turn text such as `5d` into a
+     * duration, loads only use this with sConfLoadOptions::inferTypes.
+     *
+     * @param text The trimmed value text as written in the file.
+     * @return The undecoded value.
+     */
+    static sConfValue fromRaw(const std::string& text);
+
+    /**
+     * @brief Creates a value from configuration text without inferring its
+     *        type, as sConfParser::load() does by default.
+     *
+     * The value is a String holding the text, with quotes removed, or an
+     * Array of such values if the text is bracketed. The typed getters
+     * still read it as the type fromRaw() would infer, so `8080` can be
+     * read with getInteger() and `250ms` with getDuration(), while
+     * getType() and getString() keep treating it as text.
+     *
+     * @param text The trimmed value text as written in the file.
+     * @return The undecoded value.
+     */
+    static sConfValue fromText(const std::string& text);
 
     /**
      * @brief Retrieves the data type of the value.
-     * @return The type of the value as a sConfValue::Type enum.
+     * @return The type of the value as a sConfValue::Type enum; String for
+     *         scalar text created with fromText().
      */
     Type getType() const;
 
+    /**
+     * @brief Retrieves the type the typed getters read the value as.
+     * @return The same as getType(), except for text created with
+     *         fromText(), which reports the type inferred from it.
+     */
+    Type getInferredType() const;
+
     /**
      * @brief Checks if the value is an array.
      * @return `true` if the value is of type Array, `false` otherwise.
@@ -140,14 +292,32 @@ public:
     /**
      * @brief Retrieves the value as an integer.
      * @return The integer value.
-     * @throws std::runtime_error If the value is not of type Integer.
+     * @throws std::runtime_error If the value is not of type Integer or
+     *         does not fit in an `int`.
      */
     int getInteger() const;
 
+    /**
+     * @brief Retrieves the value as a 64-bit integer.
+     * @return The integer value.
+     * @throws std::runtime_error If the value is not of type Integer or
+     *         is outside the range of `std::int64_t`.
+     */
+    std::int64_t getInteger64() const;
+
+    /**
+     * @brief Retrieves the value as an unsigned 64-bit integer.
+     * @return The integer value.
+     * @throws std::runtime_error If the value is not of type Integer, or
+     *         is negative or above the range of `std::uint64_t`.
+     */
+    std::uint64_t getUnsigned() const;
+
     /**
      * @brief Retrieves the value as a double.
-     * @return The double value.
-     * @throws std::runtime_error If the value is not of type Double.
+     * @return The double value, converting integers.
+     * @throws std::runtime_error If the value is not of type Double or
+     *         Integer, or is an integer beyond 64 bits.
      */
     double getDouble() const;
 
@@ -165,13 +335,53 @@ public:
      */
     std::string getString() const;
 
+    /**
+     * @brief Formats the value as text, whatever its type.
+     *
+     * Scalars yield the text they were read from or would be saved as,
+     * e.g. `8080`, `true` or `64MiB`; arrays yield their elements
+     * separated by commas and enclosed in brackets.
+     *
+     * @return The text of the value.
+     */
+    std::string toString() const;
+
     /**
      * @brief Retrieves the value as a date.
-     * @return The date value as a `std::tm` object.
+     * @return The date value as a `std::tm` object, with the day of the
+     *         week and of the year filled in.
      * @throws std::runtime_error If the value is not of type Date.
      */
     std::tm getDate() const;
 
+    /**
+     * @brief Retrieves the value as a point in time.
+     *
+     * Dates carry no time zone and are read as UTC.
+     *
+     * @return The date value.
+     * @throws std::runtime_error If the value is not of type Date.
+     */
+    TimePoint getTimePoint() const;
+
+    /**
+     * @brief Retrieves the value as a duration.
+     * @return The duration, at nanosecond resolution; text created with
+     *         fromText() is parsed as one, such as `5d` or `1h30m`.
+     * @throws std::runtime_error If the value is not of type Duration.
+     */
+    std::chrono::nanoseconds getDuration() const;
+
+    /**
+     * @brief Retrieves the value as a number of bytes.
+     * @return The size; a non-negative integer is read as a byte count,
+     *         and text created with fromText() is parsed as a size, such
+     *         as `64MiB`.
+     * @throws std::runtime_error If the value is neither of type Size nor
+     *         a non-negative integer within 64 bits.
+     */
+    std::uint64_t getSize() const;
+
     /**
      * @brief Retrieves the value as an array of sConfValue objects.
      * @return A vector of sConfValue objects.
@@ -179,12 +389,65 @@ public:
      */
     std::vector<sConfValue> getArray() const;
 
+    /**
+     * @brief Retrieves the number of elements of an array without copying it.
+     * @return The number of elements.
+     * @throws std::runtime_error If the value is not of type Array.
+     */
+    std::size_t getArraySize() const;
+
+    /**
+     * @brief Retrieves an array element without copying the array.
+     * @param index The position of the element.
+     * @return A reference to the element, valid as long as this value is
+     *         not modified.
+     * @throws std::runtime_error If the value is not of type Array or the
+     *         index is out of range.
+     */
+    const sConfValue& getElement(std::size_t index) const;
+
+    /**
+     * @brief Retrieves the value as a given type without throwing.
+     *
+     * Follows the same conversions as the throwing getters: an integer
+     * may be read as a double, while a string must be of type String.
+     * Use toString() for the text of a value of any type.
+     *
+     * Types that copy strings or arrays (`std::string`,
+     * `std::vector<sConfValue>` and `sConfValue`) may throw
+     * `std::bad_alloc`; every other type never throws nor allocates. Use
+     * `std::string_view` to read a string without copying it.
+     *
+     * @tparam T One of `int`, `std::int64_t`, `double`, `bool`,
+     *         `std::string`, `std::string_view` (valid as long as this
+     *         value is not modified), `std::tm`,
+     *         `TimePoint`, `std::chrono::nanoseconds` (a duration),
+     *         `std::uint64_t` (a non-negative integer or a size),
+     *         `std::vector<sConfValue>` or `sConfValue`.
+     * @return The value, `sConfError::TypeMismatch`, or
+     *         `sConfError::OutOfRange` for an integer that does not fit.
+     */
+    template<typename T>
+    sConfResult<T> tryAs() const noexcept(std::is_nothrow_copy_constructible_v<T>);
+
     /**
      * @brief Sets the value as an integer.
      * @param value The integer to set.
      */
     void setInteger(int value);
 
+    /**
+     * @brief Sets the value as a 64-bit integer.
+     * @param value The integer to set.
+     */
+    void setInteger64(std::int64_t value);
+
+    /**
+     * @brief Sets the value as an unsigned 64-bit integer.
+     * @param value The integer to set.
+     */
+    void setUnsigned(std::uint64_t value);
+
     /**
      * @brief Sets the value as a double.
      * @param value The double to set.
@@ -209,49 +472,210 @@ public:
      */
     void setDate(const std::tm& value);
 
+    /**
+     * @brief Sets the value as a date.
+     * @param value The point in time to set.
+     */
+    void setTimePoint(TimePoint value);
+
+    /**
+     * @brief Sets the value as a duration.
+     * @param value The duration to set.
+     */
+    void setDuration(std::chrono::nanoseconds value);
+
+    /**
+     * @brief Sets the value as a number of bytes.
+     * @param value The size to set.
+     */
+    void setSize(std::uint64_t value);
+
     /**
      * @brief Sets the value as an array of sConfValue objects.
      * @param value The vector of sConfValue objects to set.
      */
     void setArray(const std::vector<sConfValue>& value);
 
+    /**
+     * @brief Compares two values for equality of type and contents.
+     * @param other The value to compare with.
+     * @return `true` if both values have the same type and contents.
+     */
+    bool operator==(const sConfValue& other) const;
+
+    /**
+     * @brief Compares two values for inequality.
+     * @param other The value to compare with.
+     * @return `true` if the values differ in type or contents.
+     */
+    bool operator!=(const sConfValue& other) const;
+
+    /**
+     * @brief Computes the heap memory held by the value's own text.
+     * @return The bytes allocated for the string, or 0 if it fits in the
+     *         string's inline buffer.
+     */
+    std::size_t stringHeapBytes() const;
+
+    /**
+     * @brief Computes the heap memory held by the value's array elements.
+     * @return The bytes allocated for the element buffer plus everything
+     *         the elements themselves hold, or 0 for non-array values.
+     */
+    std::size_t arrayHeapBytes() const;
+
 private:
+    /**
+     * @enum State
+     * @brief Decoding state of a value created with fromRaw().
+     */
+    enum class State : unsigned char {
+        Decoded,  ///< The type and typed value are known.
+        Raw,      ///< Only the text is known.
+        Decoding  ///< The text is being decoded or copied by a thread.
+    };
+
+    /**
+     * @brief Typed storage of scalar values.
+     */
+    union Scalar {
+        std::int64_t integer;
+        std::uint64_t unsignedInteger; ///< Integers above the int64 range.
+        double real;
+        bool boolean;
+        std::int64_t date;     ///< Seconds since the Unix epoch.
+        std::int64_t duration; ///< Nanoseconds.
+        std::uint64_t size;    ///< Bytes.
+    };
+
     /**
      * @brief Stores the value as a string, regardless of the type.
+     *
+     * Holds the raw text until a value created with fromRaw() is decoded.
      */
-    std::string stringValue;
+    mutable std::string stringValue;
 
     /**
      * @brief Stores the value as an array if the type is Array.
      */
-    std::vector<sConfValue> values;
+    mutable std::vector<sConfValue> values;
 
     /**
      * @brief The current type of the value.
      */
-    Type type{Type::String};
+    mutable Type type{Type::String};
+
+    /**
+     * @brief Whether an Integer is above the range of `std::int64_t` and
+     *        held in `scalar.unsignedInteger`.
+     */
+    mutable bool aboveInt64{false};
+
+    /**
+     * @brief Whether an Integer was read from a literal beyond 64 bits;
+     *        only its text is kept, and every numeric read of it fails as
+     *        out of range.
+     */
+    mutable bool overflow{false};
 
     /**
-     * @brief Checks if a string is numeric.
+     * @brief Whether the value was created with fromText(): `type` holds
+     *        the inferred type, but the value reports itself as a String.
+     */
+    bool untyped{false};
+
+    /**
+     * @brief The decoded value if the type is not String or Array.
+     */
+    mutable Scalar scalar;
+
+    /**
+     * @brief The decoding state; `Decoding` also serves as a lock.
+     */
+    mutable std::atomic<State> state;
+
+    /**
+     * @brief Decodes the raw text, if not done yet.
+     */
+    void decode() const;
+
+    /**
+     * @brief Decodes the raw text, if not done yet, without throwing.
+     * @param inferred Whether to report the inferred type, as
+     *        getInferredType() does, rather than the one of getType().
+     * @return The type of the value; `Array` if the elements of an array
+     *         could not be allocated, the only way decoding can fail.
+     */
+    Type decodedType(bool inferred) const noexcept;
+
+    /**
+     * @brief Locks the value if it is still raw.
+     * @return `true` if the value is raw and now locked, in which case the
+     *         caller must decode it or call releaseRaw(); `false` if the
+     *         value is decoded.
+     */
+    bool acquireRaw() const;
+
+    /**
+     * @brief Unlocks a raw value locked by acquireRaw().
+     */
+    void releaseRaw() const;
+
+    /**
+     * @brief Infers the type of the raw text and decodes it in place.
+     */
+    void infer() const;
+
+    /**
+     * @brief Copies or moves the contents of another value.
+     * @param other The value to take the contents from.
+     * @param move Whether the contents of `other` may be moved from.
+     */
+    void assign(const sConfValue& other, bool move);
+
+    /**
+     * @brief Checks if a string is a decimal number, with an optional
+     *        fraction and exponent.
      * @param str The string to check.
      * @return `true` if the string represents a number, `false` otherwise.
      */
-    static bool isNumber(const std::string& str);
+    static bool isNumber(std::string_view str);
 
     /**
-     * @brief Checks if a string is an integral number.
-     * @param str The string to check.
-     * @return `true` if the string represents an integer, `false` otherwise.
+     * @brief Parses an integer literal: decimal, or hexadecimal, octal or
+     *        binary with a `0x`, `0o` or `0b` prefix, optionally negative
+     *        and with single `_` separators between digits.
+     * @param str The string to parse.
+     * @param scalar Receives the value.
+     * @param aboveInt64 Receives whether the value is above the range of
+     *        `std::int64_t` and was stored as unsigned.
+     * @param overflow Receives whether the literal is beyond 64 bits, in
+     *        which case `scalar` is left untouched.
+     * @return `true` if the string is an integer literal, whether or not
+     *         it fits.
      */
-    static bool isIntegral(const std::string& str);
+    static bool parseInteger(std::string_view str, Scalar& scalar, bool& aboveInt64, bool& overflow);
 
     /**
-     * @brief Parses a string into a date value.
-     * @param str The string representing a date.
-     * @return The parsed date as a `std::tm` object.
-     * @throws std::runtime_error If the string is not a valid date.
+     * @brief Parses a `yyyy-MM-dd` or `yyyy-MM-dd hh:mm:ss` date.
+     * @param str The string to parse.
+     * @param seconds Receives the seconds since the Unix epoch.
+     * @return `true` if the string is a valid date, `false` otherwise.
      */
-    static std::tm parseDate(const std::string& str);
+    static bool parseDate(std::string_view str, std::int64_t& seconds);
 };
 
+template<> sConfResult<int> sConfValue::tryAs<int>() const noexcept;
+template<> sConfResult<std::int64_t> sConfValue::tryAs<std::int64_t>() const noexcept;
+template<> sConfResult<double> sConfValue::tryAs<double>() const noexcept;
+template<> sConfResult<bool> sConfValue::tryAs<bool>() const noexcept;
+template<> sConfResult<std::string> sConfValue::tryAs<std::string>() const;
+template<> sConfResult<std::string_view> sConfValue::tryAs<std::string_view>() const noexcept;
+template<> sConfResult<std::tm> sConfValue::tryAs<std::tm>() const noexcept;
+template<> sConfResult<sConfValue::TimePoint> sConfValue::tryAs<sConfValue::TimePoint>() const noexcept;
+template<> sConfResult<std::chrono::nanoseconds> sConfValue::tryAs<std::chrono::nanoseconds>() const noexcept;
+template<> sConfResult<std::uint64_t> sConfValue::tryAs<std::uint64_t>() const noexcept;
+template<> sConfResult<std::vector<sConfValue>> sConfValue::tryAs<std::vector<sConfValue>>() const;
+template<> sConfResult<sConfValue> sConfValue::tryAs<sConfValue>() const;
+
 #endif
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_watcher.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Header file for the sConfWatcher class, which hot-reloads
+ *        configuration files in the background.
+ */
+#ifndef SCONF_WATCHER_HPP
+#define SCONF_WATCHER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <sconf_concurrent.hpp>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class sConfWatcher
+ * @brief Watches configuration files and republishes them when they change.
+ *
+ * The watcher uses inotify to observe the directories holding the watched
+ * files, so that both in-place writes and editor-style atomic renames are
+ * noticed. Bursts of events are debounced, up to a maximum delay so that
+ * a file written continuously is still picked up, after which all watched
+ * files are parsed again, in order, into a fresh document on the watcher's own
+ * thread and published into the target sConfConcurrent. Parsing never
+ * happens on the caller's thread, and readers keep seeing the previous
+ * version until the new one is complete.
+ *
+ * A failed reload leaves the published document untouched.
+ *
+ * After each reload, all futures from nextReload() are settled first and
+ * the callbacks run afterwards. Exceptions escaping a callback are
+ * swallowed so that they cannot stop the other callbacks or the thread.
+ */
+class sConfWatcher {
+public:
+    /**
+     * @brief Callback invoked on the watcher thread after each reload.
+     */
+    using ReloadCallback = std::function<void(const sConfConcurrent::Snapshot&)>;
+
+    /**
+     * @brief Callback invoked on the watcher thread when a reload fails.
+     */
+    using ErrorCallback = std::function<void(const std::string&)>;
+
+    /**
+     * @brief Constructs a watcher for one or more files.
+     * @param target The document to publish reloaded versions into. Must
+     *        outlive the watcher.
+     * @param filenames The files to watch. They are loaded in this order
+     *        into one document, so later files override earlier ones.
+     * @param debounce How long the files must stay quiet after a change
+     *        before they are parsed again.
+     * @param maxDelay The longest a change waits for the files to go
+     *        quiet; once it has passed, the files are parsed again even
+     *        if events keep arriving.
+     */
+    sConfWatcher(
+        sConfConcurrent& target,
+        std::vector<std::string> filenames,
+        std::chrono::milliseconds debounce = std::chrono::milliseconds(100),
+        std::chrono::milliseconds maxDelay = std::chrono::milliseconds(1000)
+    ) :
+        target(target),
+        filenames(std::move(filenames)),
+        debounce(debounce),
+        maxDelay(maxDelay),
+        running(false),
+        wakeFd(-1) {}
+
+    sConfWatcher(const sConfWatcher&) = delete;
+    sConfWatcher& operator=(const sConfWatcher&) = delete;
+
+    /**
+     * @brief Stops the watcher thread, if running.
+     */
+    ~sConfWatcher();
+
+    /**
+     * @brief Starts watching on a background thread.
+     *
+     * The files are loaded once right away on that thread; use
+     * nextReload() to wait for the initial document.
+     *
+     * A watcher whose thread already stopped on its own, for instance
+     * after a poll error, can be started again.
+     *
+     * @throws SconfException If the watcher is already running, if
+     *         inotify is unavailable, or if a directory cannot be watched.
+     */
+    void start();
+
+    /**
+     * @brief Stops watching and joins the background thread.
+     *
+     * Pending futures from nextReload() are abandoned.
+     */
+    void stop();
+
+    /**
+     * @brief Checks whether the background thread is running.
+     *
+     * Turns `false` as soon as the thread leaves its loop, whether through
+     * stop() or because waiting for file events failed.
+     *
+     * @return `true` if the watcher is running, `false` otherwise.
+     */
+    bool isRunning() const noexcept;
+
+    /**
+     * @brief Registers a callback invoked after every successful reload.
+     * @param callback The callback, run on the watcher thread.
+     */
+    void onReload(ReloadCallback callback);
+
+    /**
+     * @brief Registers a callback invoked when a reload fails.
+     * @param callback The callback receiving the error message, run on the
+     *        watcher thread.
+     */
+    void onError(ErrorCallback callback);
+
+    /**
+     * @brief Retrieves a future for the next completed reload.
+     * @return A future holding the published snapshot, or the reload error.
+     */
+    std::future<sConfConcurrent::Snapshot> nextReload();
+
+private:
+    /**
+     * @brief Body of the background thread.
+     * @param inotifyFd The inotify instance, owned by the thread.
+     */
+    void run(int inotifyFd);
+
+    /**
+     * @brief Parses all watched files and publishes the result.
+     */
+    void reload();
+
+    /**
+     * @brief Checks whether a changed directory entry is a watched file.
+     * @param directory The watched directory reporting the event.
+     * @param name The name of the changed entry.
+     * @return `true` if the entry is one of the watched files.
+     */
+    bool isWatched(const std::string& directory, const std::string& name) const;
+
+    /**
+     * @brief The document reloaded versions are published into.
+     */
+    sConfConcurrent& target;
+
+    /**
+     * @brief The watched files, in load order.
+     */
+    std::vector<std::string> filenames;
+
+    /**
+     * @brief Quiet period required before reloading.
+     */
+    std::chrono::milliseconds debounce;
+
+    /**
+     * @brief Longest wait between the first change and the reload.
+     */
+    std::chrono::milliseconds maxDelay;
+
+    /**
+     * @brief Set while the background thread should keep running.
+     */
+    std::atomic<bool> running;
+
+    /**
+     * @brief Event descriptor used to wake the thread on stop().
+     */
+    int wakeFd;
+
+    /**
+     * @brief Watched directories, keyed by inotify watch descriptor.
+     */
+    std::unordered_map<int, std::string> directories;
+
+    /**
+     * @brief The background thread.
+     */
+    std::thread worker;
+
+    /**
+     * @brief Guards the callbacks and pending promises.
+     */
+    mutable std::mutex callbackMutex;
+
+    /**
+     * @brief Callbacks invoked after successful reloads.
+     */
+    std::vector<ReloadCallback> reloadCallbacks;
+
+    /**
+     * @brief Callbacks invoked after failed reloads.
+     */
+    std::vector<ErrorCallback> errorCallbacks;
+
+    /**
+     * @brief Promises handed out by nextReload() and not yet fulfilled.
+     */
+    std::vector<std::promise<sConfConcurrent::Snapshot>> pending;
+};
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf_concurrent.hpp>
+#include <sconf_exception.hpp>
+
+const sConfParser& sConfConcurrent::Reader::get() {
+    std::uint64_t latest = this->source.version();
+    if(latest != this->cachedVersion) {
+        this->cachedVersion = latest;
+        this->cached = this->source.snapshot();
+    }
+
+    return *this->cached;
+}
+
+sConfConcurrent::Snapshot sConfConcurrent::snapshot() const {
+    return std::atomic_load(&this->current);
+}
+
+std::uint64_t sConfConcurrent::version() const noexcept {
+    return this->generation.load(std::memory_order_acquire);
+}
+
+void sConfConcurrent::publish(sConfParser parser) {
+    Snapshot next = std::make_shared<const sConfParser>(std::move(parser));
+
+    std::lock_guard<std::mutex> lock(this->writerMutex);
+    this->store(std::move(next));
+}
+
+void sConfConcurrent::publish(Snapshot snapshot) {
+    if(!snapshot)
+        throw SconfException("Cannot publish an empty snapshot");
+
+    std::lock_guard<std::mutex> lock(this->writerMutex);
+    this->store(std::move(snapshot));
+}
+
+void sConfConcurrent::load(const std::string& filename) {
+    sConfParser parser;
+    parser.load(filename);
+
+    this->publish(std::move(parser));
+}
+
+void sConfConcurrent::store(Snapshot snapshot) {
+    std::atomic_store(&this->current, std::move(snapshot));
+    this->generation.fetch_add(1, std::memory_order_release);
+}
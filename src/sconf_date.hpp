@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_date.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Internal fixed-format date helpers: `yyyy-MM-dd[ hh:mm:ss]`
+ *        text to and from seconds since the Unix epoch, without locales
+ *        or streams.
+ */
+#ifndef SCONF_DATE_HPP
+#define SCONF_DATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+
+namespace sConfDate {
+
+inline std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+    return value / divisor - (value % divisor < 0);
+}
+
+inline std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+
+    std::int64_t era = floorDiv(year, 400);
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+    return era * 146097 + dayOfEra - 719468;
+}
+
+inline void civilFromDays(std::int64_t days, std::int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+
+    std::int64_t era = floorDiv(days, 146097);
+    unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned shifted = (5 * dayOfYear + 2) / 153;
+
+    day = dayOfYear - (153 * shifted + 2) / 5 + 1;
+    month = shifted < 10 ? shifted + 3 : shifted - 9;
+    year = era * 400 + yearOfEra + (month <= 2);
+}
+
+inline unsigned daysInMonth(std::int64_t year, unsigned month) {
+    static const unsigned char lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+
+    return month == 2 && leap ? 29 : lengths[month - 1];
+}
+
+inline bool parse(std::string_view text, std::int64_t& seconds) {
+    static const char shape[] = "dddd-dd-dd dd:dd:dd";
+    if(text.size() != 10 && text.size() != 19)
+        return false;
+
+    for(std::size_t i = 0; i < text.size(); ++i)
+        if(shape[i] == 'd' ?
+            static_cast<unsigned char>(text[i] - '0') > 9 :
+            text[i] != shape[i])
+            return false;
+
+    auto number = [&](std::size_t pos, std::size_t count) {
+        unsigned value = 0;
+        for(std::size_t i = pos; i < pos + count; ++i)
+            value = value * 10 + static_cast<unsigned>(text[i] - '0');
+
+        return value;
+    };
+
+    unsigned year = number(0, 4), month = number(5, 2), day = number(8, 2);
+    if(month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month))
+        return false;
+
+    unsigned hour = 0, minute = 0, second = 0;
+    if(text.size() == 19) {
+        hour = number(11, 2);
+        minute = number(14, 2);
+        second = number(17, 2);
+
+        if(hour > 23 || minute > 59 || second > 59)
+            return false;
+    }
+
+    seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+inline std::string format(std::int64_t seconds) {
+    std::int64_t days = floorDiv(seconds, 86400), year;
+    unsigned month, day, time = static_cast<unsigned>(seconds - days * 86400);
+    civilFromDays(days, year, month, day);
+
+    char buffer[32];
+    char* out = buffer + sizeof(buffer);
+    auto put = [&](std::uint64_t value, int width) {
+        for(int i = 0; i < width || value != 0; ++i) {
+            *--out = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    };
+
+    put(time % 60, 2);
+    *--out = ':';
+    put(time / 60 % 60, 2);
+    *--out = ':';
+    put(time / 3600, 2);
+    *--out = ' ';
+    put(day, 2);
+    *--out = '-';
+    put(month, 2);
+    *--out = '-';
+    put(static_cast<std::uint64_t>(year < 0 ? -year : year), 4);
+    if(year < 0)
+        *--out = '-';
+
+    return std::string(out, buffer + sizeof(buffer));
+}
+
+inline std::int64_t fromTm(const std::tm& time) {
+    std::int64_t months = static_cast<std::int64_t>(time.tm_year) * 12 + time.tm_mon;
+    std::int64_t year = 1900 + floorDiv(months, 12);
+    unsigned month = static_cast<unsigned>(months - floorDiv(months, 12) * 12) + 1;
+
+    return (daysFromCivil(year, month, 1) + time.tm_mday - 1) * 86400 +
+        static_cast<std::int64_t>(time.tm_hour) * 3600 +
+        static_cast<std::int64_t>(time.tm_min) * 60 +
+        time.tm_sec;
+}
+
+inline std::tm toTm(std::int64_t seconds) {
+    std::int64_t days = floorDiv(seconds, 86400), year;
+    unsigned month, day, time = static_cast<unsigned>(seconds - days * 86400);
+    civilFromDays(days, year, month, day);
+
+    std::tm result{};
+    result.tm_year = static_cast<int>(year - 1900);
+    result.tm_mon = static_cast<int>(month) - 1;
+    result.tm_mday = static_cast<int>(day);
+    result.tm_hour = static_cast<int>(time / 3600);
+    result.tm_min = static_cast<int>(time / 60 % 60);
+    result.tm_sec = static_cast<int>(time % 60);
+    result.tm_wday = static_cast<int>(days - floorDiv(days + 4, 7) * 7 + 4);
+    result.tm_yday = static_cast<int>(days - daysFromCivil(year, 1, 1));
+
+    return result;
+}
+
+}
+
+#endif
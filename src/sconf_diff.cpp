@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf_diff.hpp>
+
+void sConfDiff::addSectionChange(sConfChange::Kind kind, const std::string& section) {
+    this->sectionChanges.push_back({kind, section, ""});
+}
+
+void sConfDiff::addKeyChange(
+    sConfChange::Kind kind,
+    const std::string& section,
+    const std::string& key
+) {
+    this->keyChanges.push_back({kind, section, key});
+}
+
+const std::vector<sConfChange>& sConfDiff::getSectionChanges() const {
+    return this->sectionChanges;
+}
+
+const std::vector<sConfChange>& sConfDiff::getKeyChanges() const {
+    return this->keyChanges;
+}
+
+bool sConfDiff::isEmpty() const {
+    return this->sectionChanges.empty() && this->keyChanges.empty();
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <sconf_events.hpp>
+#include <sconf_exception.hpp>
+#include <sstream>
+
+#include "sconf_text.hpp"
+
+void sConfHandler::onSection(const std::string&) {}
+void sConfHandler::onComment(const std::string&) {}
+void sConfHandler::onInclude(const std::string&) {}
+void sConfHandler::onKey(const std::string&, const std::string&) {}
+void sConfHandler::onValue(const std::string&) {}
+void sConfHandler::onArrayBegin() {}
+void sConfHandler::onArrayEnd() {}
+
+bool sConfHandler::onError(const sConfDiagnostic& diagnostic) {
+    throw SconfException(diagnostic.toString());
+}
+
+void sConfEventParser::parse(std::istream& input) {
+    std::string line;
+
+    auto mark = sConfStatsRecorder::now();
+    while(!this->stopped && std::getline(input, line)) {
+        this->recorder.lap(sConfStats::Scan, mark);
+
+        this->parseLine(line);
+        mark = sConfStatsRecorder::now();
+    }
+}
+
+void sConfEventParser::feed(const char* data, std::size_t size) {
+    const char* end = data + size;
+
+    auto mark = sConfStatsRecorder::now();
+    while(data != end && !this->stopped) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<std::size_t>(end - data)));
+        if(!newline) {
+            this->partial.append(data, end);
+            break;
+        }
+
+        this->partial.append(data, newline);
+        data = newline + 1;
+        this->recorder.lap(sConfStats::Scan, mark);
+
+        this->parseLine(this->partial);
+        this->partial.clear();
+        mark = sConfStatsRecorder::now();
+    }
+}
+
+void sConfEventParser::finish() {
+    if(!this->partial.empty() && !this->stopped)
+        this->parseLine(this->partial);
+
+    this->partial.clear();
+}
+
+void sConfEventParser::parseFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if(!file)
+        throw SconfException("Failed to open file: " + filename);
+
+    this->setPosition(filename, 0);
+    this->parse(file);
+}
+
+void sConfEventParser::parseLine(const std::string& line) {
+    auto mark = sConfStatsRecorder::now();
+    this->recorder.line(line.size() + 1);
+    ++this->lineNumber;
+
+    std::string trimmed = sConfText::trim(line);
+    mark = this->recorder.lap(sConfStats::Scan, mark);
+
+    if(trimmed.empty())
+        return;
+
+    this->column = line.find(trimmed.front()) + 1;
+
+    if(trimmed[0] == ';') {
+        std::string text = sConfText::trim(trimmed.substr(1));
+        this->recorder.lap(sConfStats::Tokenize, mark);
+
+        this->handler.onComment(text);
+        return;
+    }
+
+    if(trimmed[0] == '[' && trimmed.back() == ']') {
+        std::string name = sConfText::trimQuotes(sConfText::trim(trimmed.substr(1, trimmed.size() - 2)));
+        this->recorder.lap(sConfStats::Tokenize, mark);
+
+        this->handler.onSection(name);
+        return;
+    }
+
+    if(trimmed[0] == '@') {
+        size_t nameEnd = trimmed.find_first_of(" \t");
+        if(trimmed.compare(1, nameEnd == std::string::npos ? std::string::npos : nameEnd - 1, "include") != 0) {
+            this->fail(sConfDiagnostic::Kind::UnknownDirective, "Unknown directive: " + line);
+            return;
+        }
+
+        std::string path = nameEnd == std::string::npos ? "" : sConfText::trim(trimmed.substr(nameEnd));
+        if(!path.empty() && path[0] == '"')
+            path = path.substr(1, path.find('"', 1) - 1);
+        else path = sConfText::trim(path.substr(0, path.find(';')));
+        this->recorder.lap(sConfStats::Tokenize, mark);
+
+        if(path.empty()) {
+            this->fail(sConfDiagnostic::Kind::MissingIncludePath, "Missing path in include directive: " + line);
+            return;
+        }
+
+        this->handler.onInclude(path);
+        return;
+    }
+
+    size_t eqPos = trimmed.find('=');
+    if(eqPos == std::string::npos) {
+        this->fail(sConfDiagnostic::Kind::InvalidKeyValue, "Invalid key-value pair: " + line);
+        return;
+    }
+
+    std::string key = sConfText::trimQuotes(sConfText::trim(trimmed.substr(0, eqPos)));
+    std::string value = sConfText::trim(trimmed.substr(eqPos + 1));
+
+    size_t valueStart = trimmed.find_first_not_of(" \t\n\v\f\r", eqPos + 1);
+    this->valueColumn = this->column + (valueStart == std::string::npos ? trimmed.size() : valueStart);
+
+    size_t commentPos = value.find(';');
+    if(commentPos != std::string::npos)
+        value = sConfText::trim(value.substr(0, commentPos));
+    this->recorder.lap(sConfStats::Tokenize, mark);
+
+    this->handler.onKey(key, value);
+    if(sConfText::isArray(value))
+        this->parseArray(value);
+    else this->handler.onValue(sConfText::trimQuotes(value));
+}
+
+void sConfEventParser::setPosition(const std::string& source, std::size_t lineNumber) {
+    this->source = source;
+    this->lineNumber = lineNumber;
+}
+
+const std::string& sConfEventParser::getSource() const {
+    return this->source;
+}
+
+std::size_t sConfEventParser::getLineNumber() const {
+    return this->lineNumber;
+}
+
+std::size_t sConfEventParser::getColumn() const {
+    return this->column;
+}
+
+std::size_t sConfEventParser::getValueColumn() const {
+    return this->valueColumn;
+}
+
+bool sConfEventParser::isStopped() const {
+    return this->stopped;
+}
+
+void sConfEventParser::stop() {
+    this->stopped = true;
+}
+
+void sConfEventParser::fail(sConfDiagnostic::Kind kind, const std::string& message) {
+    sConfDiagnostic diagnostic{kind, this->source, this->lineNumber, this->column, message};
+    if(!this->handler.onError(diagnostic))
+        this->stopped = true;
+}
+
+void sConfEventParser::parseArray(const std::string& value) {
+    std::istringstream stream(value.substr(1, value.size() - 2));
+    std::string item;
+
+    this->handler.onArrayBegin();
+    while(std::getline(stream, item, ',')) {
+        std::string trimmed = sConfText::trimQuotes(sConfText::trim(item));
+
+        if(sConfText::isArray(trimmed))
+            this->parseArray(trimmed);
+        else this->handler.onValue(trimmed);
+    }
+
+    this->handler.onArrayEnd();
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_glob.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Internal shell-style wildcard matching.
+ */
+#ifndef SCONF_GLOB_HPP
+#define SCONF_GLOB_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace sConfGlob {
+
+inline bool matchClass(const std::string& pattern, std::size_t& pos, char c) {
+    std::size_t start = pos + 1;
+    bool negated = start < pattern.size() && (pattern[start] == '!' || pattern[start] == '^');
+    if(negated)
+        ++start;
+
+    std::size_t end = start;
+    if(end < pattern.size() && pattern[end] == ']')
+        ++end;
+    while(end < pattern.size() && pattern[end] != ']')
+        ++end;
+
+    if(end >= pattern.size())
+        return false;
+
+    bool found = false;
+    for(std::size_t i = start; i < end; ++i)
+        if(i + 2 < end && pattern[i + 1] == '-') {
+            if(pattern[i] <= c && c <= pattern[i + 2])
+                found = true;
+            i += 2;
+        }
+        else if(pattern[i] == c)
+            found = true;
+
+    pos = end;
+    return found != negated;
+}
+
+inline bool match(const std::string& pattern, const std::string& text) {
+    std::size_t p = 0, t = 0;
+    std::size_t starPattern = std::string::npos, starText = 0;
+
+    while(t < text.size()) {
+        if(p < pattern.size() && pattern[p] == '*') {
+            starPattern = p++;
+            starText = t;
+
+            continue;
+        }
+
+        std::size_t next = p;
+        bool matched = false;
+
+        if(p < pattern.size()) {
+            if(pattern[p] == '?')
+                matched = true;
+            else if(pattern[p] == '[')
+                matched = matchClass(pattern, next, text[t]);
+            else if(pattern[p] == '\\' && p + 1 < pattern.size())
+                matched = pattern[++next] == text[t];
+            else matched = pattern[p] == text[t];
+        }
+
+        if(matched) {
+            p = next + 1;
+            ++t;
+        }
+        else if(starPattern != std::string::npos) {
+            p = starPattern + 1;
+            t = ++starText;
+        }
+        else return false;
+    }
+
+    while(p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_hash.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Internal 64-bit content hash (XXH64) used for change detection.
+ */
+#ifndef SCONF_HASH_HPP
+#define SCONF_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace sConfHash {
+
+constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t rotl(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t read64(const unsigned char* data) {
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t read32(const unsigned char* data) {
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t round(std::uint64_t accumulator, std::uint64_t input) {
+    accumulator += input * Prime2;
+    accumulator = rotl(accumulator, 31);
+    return accumulator * Prime1;
+}
+
+inline std::uint64_t mergeRound(std::uint64_t accumulator, std::uint64_t value) {
+    accumulator ^= round(0, value);
+    return accumulator * Prime1 + Prime4;
+}
+
+/**
+ * @brief Hashes a byte range with XXH64.
+ * @param bytes The data to hash.
+ * @param length The number of bytes to hash.
+ * @param seed The seed, which can be a previous hash to chain ranges.
+ * @return The 64-bit hash.
+ */
+inline std::uint64_t hash64(const void* bytes, std::size_t length, std::uint64_t seed = 0) {
+    const auto* data = static_cast<const unsigned char*>(bytes);
+    const unsigned char* end = data + length;
+    std::uint64_t hash;
+
+    if(length >= 32) {
+        std::uint64_t v1 = seed + Prime1 + Prime2,
+            v2 = seed + Prime2,
+            v3 = seed,
+            v4 = seed - Prime1;
+
+        const unsigned char* limit = end - 32;
+        do {
+            v1 = round(v1, read64(data));
+            v2 = round(v2, read64(data + 8));
+            v3 = round(v3, read64(data + 16));
+            v4 = round(v4, read64(data + 24));
+            data += 32;
+        } while(data <= limit);
+
+        hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    }
+    else hash = seed + Prime5;
+
+    hash += static_cast<std::uint64_t>(length);
+    while(data + 8 <= end) {
+        hash ^= round(0, read64(data));
+        hash = rotl(hash, 27) * Prime1 + Prime4;
+        data += 8;
+    }
+
+    if(data + 4 <= end) {
+        hash ^= static_cast<std::uint64_t>(read32(data)) * Prime1;
+        hash = rotl(hash, 23) * Prime2 + Prime3;
+        data += 4;
+    }
+
+    while(data < end) {
+        hash ^= (*data) * Prime5;
+        hash = rotl(hash, 11) * Prime1;
+        ++data;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <sconf_exception.hpp>
+#include <sconf_interpolation.hpp>
+
+bool sConfInterpolation::isTemplate(const std::string& text) {
+    return text.find("${") != std::string::npos;
+}
+
+std::vector<sConfInterpolation::Reference> sConfInterpolation::references(const std::string& text) {
+    std::vector<Reference> found;
+
+    expand(text, [&found](const Reference& reference) {
+        found.push_back(reference);
+        return std::string();
+    });
+
+    return found;
+}
+
+bool sConfInterpolation::isWholeReference(const std::string& text, Reference& reference) {
+    if(text.size() < 4 || text.compare(0, 2, "${") != 0 || text.back() != '}' ||
+        text.find('}') != text.size() - 1)
+        return false;
+
+    std::vector<Reference> found = references(text);
+    if(found.size() != 1)
+        return false;
+
+    reference = found.front();
+    return true;
+}
+
+std::string sConfInterpolation::expand(const std::string& text, const Resolver& resolve) {
+    std::string result;
+    result.reserve(text.size());
+
+    for(size_t i = 0; i < text.size();) {
+        if(text.compare(i, 3, "$${") == 0) {
+            result += "${";
+            i += 3;
+            continue;
+        }
+
+        if(text.compare(i, 2, "${") != 0) {
+            result += text[i++];
+            continue;
+        }
+
+        size_t close = text.find('}', i + 2);
+        if(close == std::string::npos)
+            throw SconfException("Unterminated reference in: " + text);
+
+        std::string body = text.substr(i + 2, close - i - 2);
+        Reference reference{false, {}};
+
+        if(body.compare(0, 4, "ENV:") == 0) {
+            reference.environment = true;
+            reference.target.key = body.substr(4);
+        }
+        else {
+            size_t dot = body.rfind('.');
+            if(dot == std::string::npos || dot == 0)
+                throw SconfException("Invalid reference: ${" + body + "}");
+
+            reference.target.section = body.substr(0, dot);
+            reference.target.key = body.substr(dot + 1);
+        }
+
+        if(reference.target.key.empty())
+            throw SconfException("Invalid reference: ${" + body + "}");
+
+        result += resolve(reference);
+        i = close + 1;
+    }
+
+    return result;
+}
+
+void sConfInterpolation::set(const Key& key, const std::string& text) {
+    Node node{key, text, {}};
+    for(const auto& reference : references(text))
+        if(!reference.environment)
+            node.uses.push_back(id(reference.target));
+
+    std::sort(node.uses.begin(), node.uses.end());
+    node.uses.erase(std::unique(node.uses.begin(), node.uses.end()), node.uses.end());
+
+    std::string identifier = id(key);
+    this->erase(key);
+
+    for(const auto& used : node.uses)
+        this->users[used].push_back(identifier);
+    this->templates.emplace(identifier, std::move(node));
+}
+
+void sConfInterpolation::erase(const Key& key) {
+    std::string identifier = id(key);
+    auto it = this->templates.find(identifier);
+    if(it == this->templates.end())
+        return;
+
+    this->unlink(identifier, it->second);
+    this->templates.erase(it);
+}
+
+void sConfInterpolation::eraseSection(const std::string& section) {
+    for(auto it = this->templates.begin(); it != this->templates.end();)
+        if(it->second.key.section == section) {
+            this->unlink(it->first, it->second);
+            it = this->templates.erase(it);
+        }
+        else ++it;
+}
+
+const std::string* sConfInterpolation::find(const Key& key) const {
+    auto it = this->templates.find(id(key));
+    return it == this->templates.end() ? nullptr : &it->second.text;
+}
+
+bool sConfInterpolation::empty() const {
+    return this->templates.empty();
+}
+
+std::vector<sConfInterpolation::Key> sConfInterpolation::keys() const {
+    std::vector<Key> result;
+    result.reserve(this->templates.size());
+
+    for(const auto& [_, node] : this->templates)
+        result.push_back(node.key);
+    return result;
+}
+
+std::vector<sConfInterpolation::Key> sConfInterpolation::order() const {
+    std::unordered_map<std::string, int> marks;
+    std::vector<std::string> path;
+    std::vector<Key> result;
+    result.reserve(this->templates.size());
+
+    for(const auto& [identifier, _] : this->templates)
+        this->visit(identifier, nullptr, marks, path, result);
+    return result;
+}
+
+std::vector<sConfInterpolation::Key> sConfInterpolation::dependents(const Key& key) const {
+    std::unordered_set<std::string> affected;
+    std::vector<std::string> pending{id(key)};
+
+    if(this->templates.count(pending.front()))
+        affected.insert(pending.front());
+
+    while(!pending.empty()) {
+        std::string current = std::move(pending.back());
+        pending.pop_back();
+
+        auto it = this->users.find(current);
+        if(it == this->users.end())
+            continue;
+
+        for(const auto& user : it->second)
+            if(affected.insert(user).second)
+                pending.push_back(user);
+    }
+
+    std::unordered_map<std::string, int> marks;
+    std::vector<std::string> path;
+    std::vector<Key> result;
+
+    for(const auto& identifier : affected)
+        this->visit(identifier, &affected, marks, path, result);
+
+    return result;
+}
+
+std::string sConfInterpolation::id(const Key& key) {
+    return key.section + '\0' + key.key;
+}
+
+std::string sConfInterpolation::name(const Key& key) {
+    return key.section + "." + key.key;
+}
+
+void sConfInterpolation::unlink(const std::string& identifier, const Node& node) {
+    for(const auto& used : node.uses) {
+        auto it = this->users.find(used);
+        if(it == this->users.end())
+            continue;
+
+        auto& list = it->second;
+        list.erase(std::remove(list.begin(), list.end(), identifier), list.end());
+        if(list.empty())
+            this->users.erase(it);
+    }
+}
+
+void sConfInterpolation::visit(
+    const std::string& identifier,
+    const std::unordered_set<std::string>* include,
+    std::unordered_map<std::string, int>& marks,
+    std::vector<std::string>& path,
+    std::vector<Key>& result
+) const {
+    auto node = this->templates.find(identifier);
+    if(node == this->templates.end())
+        return;
+
+    int& mark = marks[identifier];
+    if(mark == 2)
+        return;
+
+    if(mark == 1) {
+        std::string cycle;
+        for(auto it = std::find(path.begin(), path.end(), identifier); it != path.end(); ++it)
+            cycle += name(this->templates.at(*it).key) + " -> ";
+
+        throw SconfException("Interpolation cycle: " + cycle + name(node->second.key));
+    }
+
+    mark = 1;
+    path.push_back(identifier);
+
+    for(const auto& used : node->second.uses)
+        this->visit(used, include, marks, path, result);
+
+    path.pop_back();
+    marks[identifier] = 2;
+
+    if(!include || include->count(identifier))
+        result.push_back(node->second.key);
+}
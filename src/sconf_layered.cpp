@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <sconf_exception.hpp>
+#include <sconf_layered.hpp>
+
+#include "sconf_hash.hpp"
+#include "sconf_text.hpp"
+
+void sConfLayered::addLayer(const std::string& name, const sConfParser& layer) {
+    for(const auto& existing : this->layers)
+        if(existing->name == name)
+            throw SconfException("Layer already exists: " + name);
+
+    this->layers.push_back(std::unique_ptr<Layer>(
+        new Layer{name, this->layers.size(), layer, collect(layer)}
+    ));
+    this->claim(*this->layers.back());
+}
+
+void sConfLayered::setLayer(const std::string& name, const sConfParser& layer) {
+    Layer& target = this->findLayer(name);
+    std::unordered_map<std::string, sConfValue> previous = std::move(target.values);
+
+    target.document = layer;
+    target.values = collect(layer);
+
+    this->claim(target);
+    this->release(target, previous);
+}
+
+void sConfLayered::removeLayer(const std::string& name) {
+    Layer& target = this->findLayer(name);
+    std::unordered_map<std::string, sConfValue> previous = std::move(target.values);
+
+    target.values.clear();
+    this->release(target, previous);
+
+    this->layers.erase(this->layers.begin() + target.rank);
+    for(size_t rank = 0; rank < this->layers.size(); ++rank)
+        this->layers[rank]->rank = rank;
+}
+
+const sConfParser& sConfLayered::getLayer(const std::string& name) const {
+    return this->findLayer(name).document;
+}
+
+std::vector<std::string> sConfLayered::getLayerNames() const {
+    std::vector<std::string> names;
+    names.reserve(this->layers.size());
+
+    for(const auto& layer : this->layers)
+        names.push_back(layer->name);
+    return names;
+}
+
+std::vector<std::string> sConfLayered::getSections() const {
+    std::vector<std::string> sections;
+    sections.reserve(this->sectionKeys.size());
+
+    for(const auto& [section, _] : this->sectionKeys)
+        sections.push_back(section);
+    return sections;
+}
+
+bool sConfLayered::hasKey(std::string_view section, std::string_view key) const {
+    return this->lookup(sConfText::normalize(section), sConfText::normalize(key)) != nullptr;
+}
+
+const sConfValue& sConfLayered::getValue(std::string_view section, std::string_view key) const {
+    return *this->findWinner(section, key).value;
+}
+
+const std::string& sConfLayered::getWinningLayer(std::string_view section, std::string_view key) const {
+    return this->findWinner(section, key).layer->name;
+}
+
+sConfParser sConfLayered::flatten() const {
+    sConfParser result;
+
+    for(const auto& [_, winner] : this->index) {
+        const std::string& identifier = *winner.identifier;
+        size_t separator = identifier.find('\0');
+        std::string section = identifier.substr(0, separator);
+
+        result.addSection(section);
+        result.setKey(section, identifier.substr(separator + 1), *winner.value);
+    }
+
+    return result;
+}
+
+std::string sConfLayered::id(const std::string& section, const std::string& key) {
+    return section + '\0' + key;
+}
+
+std::uint64_t sConfLayered::hash(std::string_view section, std::string_view key) {
+    return sConfHash::hash64(key.data(), key.size(), sConfHash::hash64(section.data(), section.size()));
+}
+
+bool sConfLayered::matches(const std::string& identifier, std::string_view section, std::string_view key) {
+    return identifier.size() == section.size() + 1 + key.size() &&
+        identifier.compare(0, section.size(), section) == 0 &&
+        identifier[section.size()] == '\0' &&
+        identifier.compare(section.size() + 1, key.size(), key) == 0;
+}
+
+std::unordered_map<std::string, sConfValue> sConfLayered::collect(const sConfParser& document) {
+    std::unordered_map<std::string, sConfValue> values;
+
+    for(const auto& section : document.getSections())
+        for(auto& [key, value] : document.getSection(section))
+            values.emplace(id(section, key), std::move(value));
+
+    return values;
+}
+
+sConfLayered::Layer& sConfLayered::findLayer(const std::string& name) const {
+    for(const auto& layer : this->layers)
+        if(layer->name == name)
+            return *layer;
+
+    throw SconfException("Layer not found: " + name);
+}
+
+const sConfLayered::Winner* sConfLayered::lookup(std::string_view section, std::string_view key) const noexcept {
+    auto [first, last] = this->index.equal_range(hash(section, key));
+
+    for(auto it = first; it != last; ++it)
+        if(matches(*it->second.identifier, section, key))
+            return &it->second;
+
+    return nullptr;
+}
+
+const sConfLayered::Winner& sConfLayered::findWinner(std::string_view section, std::string_view key) const {
+    const Winner* winner = this->lookup(sConfText::normalize(section), sConfText::normalize(key));
+    if(!winner)
+        throw SconfException("Key not found in any layer: " + std::string(section) + "." + std::string(key));
+
+    return *winner;
+}
+
+void sConfLayered::claim(const Layer& layer) {
+    for(const auto& [identifier, value] : layer.values) {
+        std::string_view view(identifier);
+        size_t separator = view.find('\0');
+        const Winner* current = this->lookup(view.substr(0, separator), view.substr(separator + 1));
+
+        if(!current || current->layer->rank <= layer.rank)
+            this->assign(identifier, {&layer, &value, &identifier});
+    }
+}
+
+void sConfLayered::release(const Layer& layer, const std::unordered_map<std::string, sConfValue>& values) {
+    for(const auto& [identifier, _] : values) {
+        if(layer.values.count(identifier))
+            continue;
+
+        std::string_view view(identifier);
+        size_t separator = view.find('\0');
+        const Winner* current = this->lookup(view.substr(0, separator), view.substr(separator + 1));
+        if(!current || current->layer != &layer)
+            continue;
+
+        Winner next{nullptr, nullptr, nullptr};
+        for(size_t rank = layer.rank; rank-- > 0 && !next.layer;) {
+            const Layer& lower = *this->layers[rank];
+            auto value = lower.values.find(identifier);
+
+            if(value != lower.values.end())
+                next = {&lower, &value->second, &value->first};
+        }
+
+        this->assign(identifier, next);
+    }
+}
+
+void sConfLayered::assign(const std::string& identifier, Winner winner) {
+    std::string_view view(identifier);
+    size_t separator = view.find('\0');
+    std::uint64_t key = hash(view.substr(0, separator), view.substr(separator + 1));
+
+    auto [first, last] = this->index.equal_range(key);
+    auto it = std::find_if(first, last, [&](const auto& entry) {
+        return *entry.second.identifier == identifier;
+    });
+
+    if(it != last && winner.layer) {
+        it->second = winner;
+        return;
+    }
+
+    if(it == last && !winner.layer)
+        return;
+
+    std::string section = identifier.substr(0, separator);
+    if(winner.layer) {
+        this->index.emplace(key, winner);
+        ++this->sectionKeys[section];
+    }
+    else {
+        this->index.erase(it);
+        if(--this->sectionKeys[section] == 0)
+            this->sectionKeys.erase(section);
+    }
+}
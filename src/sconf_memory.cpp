@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <sconf_memory.hpp>
+#include <sstream>
+
+std::size_t sConfMemoryUsage::SectionUsage::total() const {
+    return this->keyBytes + this->valueBytes + this->arrayBytes +
+        this->tableBytes + this->commentBytes;
+}
+
+std::size_t sConfMemoryUsage::total() const {
+    return this->keyBytes + this->valueBytes + this->arrayBytes +
+        this->tableBytes + this->commentBytes + this->sourceBytes;
+}
+
+std::vector<sConfMemoryUsage::SectionUsage> sConfMemoryUsage::largest(std::size_t count) const {
+    std::vector<SectionUsage> result(this->sections);
+    std::stable_sort(
+        result.begin(),
+        result.end(),
+        [](const SectionUsage& a, const SectionUsage& b) {
+            return a.total() > b.total();
+        }
+    );
+
+    if(result.size() > count)
+        result.resize(count);
+    return result;
+}
+
+std::string sConfMemoryUsage::report(std::size_t topCount) const {
+    std::ostringstream out;
+    auto row = [&](const std::string& label, std::size_t bytes) {
+        out << "  " << std::left << std::setw(10) << label
+            << std::right << std::setw(12) << bytes << " B\n";
+    };
+
+    out << "Memory usage (" << this->sections.size() << " sections):\n";
+    row("keys", this->keyBytes);
+    row("values", this->valueBytes);
+    row("arrays", this->arrayBytes);
+    row("tables", this->tableBytes);
+    row("comments", this->commentBytes);
+    if(this->sourceBytes != 0)
+        row("source", this->sourceBytes);
+    if(this->pendingBytes != 0)
+        row("  pending", this->pendingBytes);
+    row("total", this->total());
+
+    std::vector<SectionUsage> top = this->largest(topCount);
+    if(top.empty())
+        return out.str();
+
+    out << "Largest sections:\n";
+    for(const auto& section : top)
+        out << "  " << std::setw(12) << section.total() << " B  "
+            << section.name << " (" << section.keys << " keys"
+            << (section.pendingBytes ? ", " + std::to_string(section.pendingBytes) + " B unparsed" : "")
+            << (section.shared ? ", shared" : "") << ")\n";
+
+    return out.str();
+}
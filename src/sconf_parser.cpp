@@ -17,152 +17,1534 @@
  */
 
 #include <algorithm>
+#include <deque>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <iterator>
+#include <mutex>
 #include <sconf_exception.hpp>
 #include <sconf_parser.hpp>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+#include <sys/stat.h>
+
+#include "sconf_date.hpp"
+#include "sconf_glob.hpp"
+#include "sconf_hash.hpp"
+#include "sconf_text.hpp"
+#include "sconf_units.hpp"
 
 std::string sConfParser::trim(const std::string& str) {
-    auto start = std::find_if_not(str.begin(), str.end(), [](char c) { 
-        return std::isspace(c); 
+    return sConfText::trim(str);
+}
+
+std::string sConfParser::trimQuotes(const std::string& str) {
+    return sConfText::trimQuotes(str);
+}
+
+static void recordAllocations(
+    const sConfStatsRecorder& recorder,
+    bool inserted,
+    const std::string& key,
+    const sConfValue& value
+) {
+#ifdef SCONF_ENABLE_STATS
+    static const size_t inlineCapacity = std::string().capacity();
+
+    if(inserted) {
+        recorder.allocation(sizeof(std::pair<const std::string, sConfValue>) + 2 * sizeof(void*));
+        if(key.size() > inlineCapacity)
+            recorder.allocation(key.size() + 1);
+    }
+
+    if(size_t bytes = value.stringHeapBytes())
+        recorder.allocation(bytes);
+
+    if(size_t bytes = value.arrayHeapBytes())
+        recorder.allocation(bytes);
+#else
+    (void) recorder;
+    (void) inserted;
+    (void) key;
+    (void) value;
+#endif
+}
+
+static size_t stringHeapBytes(const std::string& str) {
+    static const size_t inlineCapacity = std::string().capacity();
+    return str.capacity() > inlineCapacity ? str.capacity() + 1 : 0;
+}
+
+static constexpr size_t hashNodeOverhead = sizeof(void*) + sizeof(size_t);
+
+// Defined at namespace scope, so they outlive the include cache whose
+// workers may still be interning names while the process exits.
+static std::mutex sourceMutex;
+static std::deque<std::string> sourceNames;
+static std::unordered_map<std::string, std::uint32_t> sourceIds;
+
+static std::uint32_t internSource(const std::string& path) {
+    if(path.empty())
+        return 0;
+
+    std::lock_guard<std::mutex> lock(sourceMutex);
+    auto [it, inserted] = sourceIds.try_emplace(path, static_cast<std::uint32_t>(sourceNames.size() + 1));
+    if(inserted)
+        sourceNames.push_back(path);
+
+    return it->second;
+}
+
+static std::string sourceName(std::uint32_t id) {
+    if(id == 0)
+        return "";
+
+    std::lock_guard<std::mutex> lock(sourceMutex);
+    return sourceNames[id - 1];
+}
+
+static std::uint32_t narrow(size_t value) {
+    return static_cast<std::uint32_t>(std::min<size_t>(value, UINT32_MAX));
+}
+
+void sConfParser::SectionHashes::onSection(const std::string& name) {
+    this->currentSection = name;
+    this->content("[" + name + "]");
+}
+
+void sConfParser::SectionHashes::onComment(const std::string& text) {
+    this->pendingComments.push_back(sConfHash::hash64(text.data(), text.size()));
+}
+
+void sConfParser::SectionHashes::onInclude(const std::string& path) {
+    this->content("@include " + path);
+}
+
+void sConfParser::SectionHashes::onKey(const std::string& key, const std::string& rawValue) {
+    this->content(key + "=" + rawValue);
+}
+
+void sConfParser::SectionHashes::content(const std::string& text) {
+    auto [it, inserted] = this->entries.try_emplace(this->currentSection);
+    if(inserted)
+        it->second.created = !this->document || !this->document->findSection(this->currentSection);
+
+    Entry& entry = it->second;
+    for(std::uint64_t commentHash : this->pendingComments)
+        entry.hash = sConfHash::hash64(&commentHash, sizeof(commentHash), entry.hash);
+
+    entry.hash = sConfHash::hash64(text.data(), text.size(), entry.hash);
+    if(this->events) {
+        std::uint32_t line = narrow(this->events->getLineNumber());
+        if(inserted)
+            entry.line = line;
+
+        std::uint32_t offset = line - entry.line;
+        entry.layout = sConfHash::hash64(&offset, sizeof(offset), entry.layout);
+    }
+
+    this->pendingComments.clear();
+}
+
+class sConfParser::IncludeCache {
+public:
+    using Handle = std::shared_future<std::shared_ptr<const IncludedFile>>;
+
+    static IncludeCache& instance() {
+        static IncludeCache cache;
+        return cache;
+    }
+
+    ~IncludeCache() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->idle.wait(lock, [this]() { return this->running == 0; });
+    }
+
+    Handle request(const std::string& path, bool inferTypes) {
+        struct stat info;
+        if(::stat(path.c_str(), &info) != 0)
+            throw SconfException("Failed to open file: " + path);
+
+        Handle stale, handle;
+        bool start = false;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            Entry& entry = this->entries[inferTypes][path];
+
+            if(!entry.parsed.valid() ||
+                entry.device != info.st_dev ||
+                entry.inode != info.st_ino ||
+                entry.size != info.st_size ||
+                entry.modified.tv_sec != info.st_mtim.tv_sec ||
+                entry.modified.tv_nsec != info.st_mtim.tv_nsec) {
+                entry.device = info.st_dev;
+                entry.inode = info.st_ino;
+                entry.size = info.st_size;
+                entry.modified = info.st_mtim;
+                entry.ticket = ++this->tickets;
+
+                Job job{
+                    path,
+                    inferTypes,
+                    entry.ticket,
+                    Task([path, inferTypes]() { return parseIncluded(path, inferTypes); })
+                };
+                stale = std::move(entry.parsed);
+                entry.parsed = job.task.get_future().share();
+                this->queue.push_back(std::move(job));
+
+                start = this->running < this->workers;
+                this->running += start;
+            }
+
+            handle = entry.parsed;
+        }
+
+        if(start)
+            this->spawn();
+
+        return handle;
+    }
+
+    void clear() {
+        std::unordered_map<std::string, Entry> released[2];
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            released[0].swap(this->entries[0]);
+            released[1].swap(this->entries[1]);
+        }
+    }
+
+private:
+    using Task = std::packaged_task<std::shared_ptr<const IncludedFile>()>;
+
+    struct Entry {
+        dev_t device = 0;
+        ino_t inode = 0;
+        off_t size = 0;
+        timespec modified{};
+        std::uint64_t ticket = 0;
+        Handle parsed;
+    };
+
+    struct Job {
+        std::string path;
+        bool inferTypes;
+        std::uint64_t ticket;
+        Task task;
+    };
+
+    void spawn() {
+        try {
+            std::thread([this]() { this->work(); }).detach();
+        }
+        catch(...) {
+            std::deque<Job> orphaned;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if(--this->running == 0) {
+                    // No worker is left to run the queued parses: forget
+                    // them so a later request starts them afresh.
+                    orphaned.swap(this->queue);
+
+                    for(const auto& job : orphaned) {
+                        auto& table = this->entries[job.inferTypes];
+                        auto it = table.find(job.path);
+
+                        if(it != table.end() && it->second.ticket == job.ticket)
+                            table.erase(it);
+                    }
+
+                    this->idle.notify_all();
+                }
+            }
+
+            throw;
+        }
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while(!this->queue.empty()) {
+            Job job = std::move(this->queue.front());
+            this->queue.pop_front();
+
+            lock.unlock();
+            job.task();
+            lock.lock();
+        }
+
+        if(--this->running == 0)
+            this->idle.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::size_t running = 0;
+    const std::size_t workers = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t tickets = 0;
+    std::deque<Job> queue;
+    std::unordered_map<std::string, Entry> entries[2];
+};
+
+class sConfParser::Loader : public sConfHandler {
+public:
+    Loader(
+        sConfParser& document,
+        sConfHandler* observer,
+        const SectionTable* reused,
+        bool deferValues
+    ) :
+        document(&document),
+        target(nullptr),
+        spans(nullptr),
+        recorder(document.statsRecorder),
+        observer(observer),
+        reused(reused),
+        deferValues(deferValues),
+        inferTypes(false),
+        skipping(reused && reused->find("") != reused->end()) {}
+
+    Loader(
+        Section& target,
+        SpanTable& spans,
+        const sConfStatsRecorder& recorder,
+        bool deferValues,
+        bool inferTypes
+    ) :
+        document(nullptr),
+        target(&target),
+        spans(&spans),
+        recorder(recorder),
+        observer(nullptr),
+        reused(nullptr),
+        deferValues(deferValues),
+        inferTypes(inferTypes),
+        skipping(false) {}
+
+    void onSection(const std::string& name) override {
+        if(this->observer)
+            this->observer->onSection(name);
+
+        this->currentSection = name;
+        this->skipping = this->reused && this->reused->find(name) != this->reused->end();
+        this->header = this->position();
+
+        if(!this->skipping && this->document) {
+            auto mark = sConfStatsRecorder::now();
+            std::vector<std::string>& sectionComments = this->document->mutableComments()[name];
+
+            sectionComments.insert(
+                sectionComments.end(),
+                this->commentBuffer.begin(),
+                this->commentBuffer.end()
+            );
+            this->recorder.lap(sConfStats::Insert, mark);
+        }
+
+        this->commentBuffer.clear();
+    }
+
+    void onComment(const std::string& text) override {
+        if(this->observer)
+            this->observer->onComment(text);
+
+        this->commentBuffer.push_back(text);
+    }
+
+    void onInclude(const std::string& path) override {
+        if(this->observer)
+            this->observer->onInclude(path);
+
+        if(this->target)
+            return;
+
+        if(this->includingFile.empty())
+            throw SconfException(this->where() + "Include directive not allowed here: " + path);
+
+        std::string resolved = resolveInclude(this->includingFile, path);
+        this->commentBuffer.clear();
+
+        try {
+            if(resolved == resolveInclude(this->includingFile, ""))
+                throw SconfException("Include cycle: " + resolved + " -> " + resolved);
+
+            IncludeCache::instance().request(resolved, this->typed());
+        }
+        catch(const SconfException& error) {
+            if(!this->errors)
+                throw;
+
+            sConfDiagnostic diagnostic{
+                sConfDiagnostic::Kind::IncludeFailed,
+                this->events ? this->events->getSource() : "",
+                this->events ? this->events->getLineNumber() : 0,
+                this->events ? this->events->getColumn() : 0,
+                error.what()
+            };
+            if(!this->report(diagnostic) && this->events)
+                this->events->stop();
+
+            return;
+        }
+
+        this->includes.push_back(resolved);
+    }
+
+    void onKey(const std::string& key, const std::string& rawValue) override {
+        if(this->observer)
+            this->observer->onKey(key, rawValue);
+
+        this->commentBuffer.clear();
+        if(this->skipping)
+            return;
+
+        auto mark = sConfStatsRecorder::now();
+        sConfValue value = this->typed() ?
+            sConfValue::fromRaw(rawValue) :
+            sConfValue::fromText(rawValue);
+        if(!this->deferValues)
+            value.getType();
+        mark = this->recorder.lap(sConfStats::Decode, mark);
+
+        SectionNode* node = this->target ?
+            nullptr :
+            &this->document->mutableNode(this->currentSection);
+        Section& section = node ? node->pairs : *this->target;
+        bool inserted = section.insert_or_assign(key, value).second;
+
+        if(this->events) {
+            KeySpan span{
+                sConfHash::hash64(key.data(), key.size()),
+                this->position(),
+                narrow(this->events->getValueColumn())
+            };
+
+            if(!node)
+                this->spans->entries.push_back(span);
+            else {
+                if(node->header.line == 0)
+                    node->header = this->header;
+                mutableSpans(*node).push_back(span);
+            }
+        }
+
+        recordAllocations(this->recorder, inserted, key, value);
+        this->recorder.lap(sConfStats::Insert, mark);
+    }
+
+    bool onError(const sConfDiagnostic& diagnostic) override {
+        if(!this->errors)
+            return sConfHandler::onError(diagnostic);
+
+        return this->report(diagnostic);
+    }
+
+    void allowIncludes(const std::string& filename) {
+        this->includingFile = filename;
+    }
+
+    const std::vector<std::string>& includedFiles() const {
+        return this->includes;
+    }
+
+    void track(sConfEventParser& events, std::uint32_t file) {
+        this->events = &events;
+        this->file = file;
+    }
+
+    void collect(std::vector<sConfDiagnostic>& errors, size_t maxErrors) {
+        this->errors = &errors;
+        this->maxErrors = maxErrors;
+    }
+
+private:
+    bool typed() const {
+        return this->document ? this->document->inferTypes : this->inferTypes;
+    }
+
+    bool report(const sConfDiagnostic& diagnostic) {
+        this->errors->push_back(diagnostic);
+        return this->maxErrors == 0 || this->errors->size() < this->maxErrors;
+    }
+
+    SourcePosition position() const {
+        if(!this->events)
+            return SourcePosition();
+
+        return {
+            this->file,
+            narrow(this->events->getLineNumber()),
+            narrow(this->events->getColumn())
+        };
+    }
+
+    std::string where() const {
+        if(!this->events)
+            return "";
+
+        return this->events->getSource() + ":" + std::to_string(this->events->getLineNumber()) + ": ";
+    }
+
+    sConfParser* document;
+    Section* target;
+    SpanTable* spans;
+    const sConfStatsRecorder& recorder;
+    sConfHandler* observer;
+    const SectionTable* reused;
+    bool deferValues;
+    bool inferTypes;
+    bool skipping;
+
+    std::string currentSection;
+    std::vector<std::string> commentBuffer;
+    std::string includingFile;
+    std::vector<std::string> includes;
+
+    sConfEventParser* events = nullptr;
+    std::uint32_t file = 0;
+    SourcePosition header;
+
+    std::vector<sConfDiagnostic>* errors = nullptr;
+    size_t maxErrors = 0;
+};
+
+void sConfParser::adoptHashes(const SectionHashes& hashes) {
+    if(!this->data)
+        return;
+
+    for(const auto& [section, entry] : hashes.entries) {
+        if(!entry.created)
+            continue;
+
+        auto it = this->data->find(section);
+        if(it != this->data->end() && it->second.use_count() == 1) {
+            it->second->sourceHash = entry.hash;
+            it->second->sourceLayout = entry.layout;
+            it->second->sourceLine = entry.line;
+        }
+    }
+}
+
+void sConfParser::shiftLines(SectionNode& node, std::int64_t delta) {
+    auto shift = [delta](std::uint32_t& line) {
+        if(line != 0)
+            line = narrow(static_cast<size_t>(std::max<std::int64_t>(1, line + delta)));
+    };
+
+    shift(node.header.line);
+    shift(node.sourceLine);
+
+    if(node.spans) {
+        if(node.spans.use_count() > 1) {
+            auto copy = std::make_shared<SpanTable>();
+            copy->entries = node.spans->entries;
+            node.spans = std::move(copy);
+        }
+
+        for(auto& span : node.spans->entries)
+            shift(span.key.line);
+    }
+
+    if(node.pending && !node.pending->materialized.load(std::memory_order_acquire)) {
+        auto copy = std::make_shared<PendingSection>();
+        copy->source = node.pending->source;
+        copy->ranges = node.pending->ranges;
+        copy->lines = node.pending->lines;
+        copy->file = node.pending->file;
+        copy->deferValues = node.pending->deferValues;
+        copy->inferTypes = node.pending->inferTypes;
+
+        for(auto& line : copy->lines)
+            shift(line);
+        node.pending = std::move(copy);
+    }
+}
+
+bool sConfParser::diffSection(
+    sConfDiff& diff,
+    const std::string& section,
+    const Section* before,
+    const Section* after
+) {
+    bool changed = false;
+
+    if(before)
+        for(const auto& [key, value] : *before) {
+            if(!after || after->find(key) == after->end())
+                diff.addKeyChange(sConfChange::Kind::Removed, section, key);
+            else if(after->at(key) != value)
+                diff.addKeyChange(sConfChange::Kind::Modified, section, key);
+            else continue;
+
+            changed = true;
+        }
+
+    if(after)
+        for(const auto& [key, _] : *after)
+            if(!before || before->find(key) == before->end()) {
+                diff.addKeyChange(sConfChange::Kind::Added, section, key);
+                changed = true;
+            }
+
+    return changed;
+}
+
+const sConfParser::Section* sConfParser::findSection(
+    const std::string& section
+) const {
+    if(!this->data)
+        return nullptr;
+
+    auto it = this->data->find(section);
+    if(it == this->data->end())
+        return nullptr;
+
+    return &this->materialize(*it->second);
+}
+
+const sConfParser::Section& sConfParser::materialize(SectionNode& node) const {
+    if(!node.pending)
+        return node.pairs;
+
+    std::call_once(node.pending->parsed, [&]() {
+        // Escaping exceptions would leave the flag to be retried, which
+        // some once implementations (such as ThreadSanitizer's) cannot
+        // do; record the error instead so every access reports it.
+        try {
+            const PendingSection& pending = *node.pending;
+            const std::string& source = *pending.source;
+            Section parsed;
+            auto spans = std::make_shared<SpanTable>();
+            Loader loader(parsed, *spans, this->statsRecorder, pending.deferValues, pending.inferTypes);
+            sConfEventParser events(loader);
+            loader.track(events, pending.file);
+
+            std::string file = sourceName(pending.file);
+            for(size_t range = 0; range < pending.ranges.size(); ++range) {
+                const auto& [begin, end] = pending.ranges[range];
+                events.setPosition(file, range < pending.lines.size() ? pending.lines[range] - 1 : 0);
+
+                for(size_t start = begin; start < end;) {
+                    size_t stop = source.find('\n', start);
+                    if(stop == std::string::npos || stop > end)
+                        stop = end;
+
+                    events.parseLine(source.substr(start, stop - start));
+                    start = stop + 1;
+                }
+            }
+
+            for(auto& [key, value] : parsed)
+                node.pairs.insert_or_assign(key, std::move(value));
+            node.spans = std::move(spans);
+            node.pending->materialized.store(true, std::memory_order_release);
+        }
+        catch(...) {
+            node.pending->failure = std::current_exception();
+        }
     });
-    auto end = std::find_if_not(str.rbegin(), str.rend(), [](char c) { 
-        return std::isspace(c); 
-    }).base();
 
-    return (start < end) ? std::string(start, end) : "";
-}
+    if(node.pending->failure)
+        std::rethrow_exception(node.pending->failure);
+
+    return node.pairs;
+}
+
+sConfParser::Section& sConfParser::mutableSection(const std::string& section) {
+    return this->mutableNode(section).pairs;
+}
+
+sConfParser::SectionNode& sConfParser::mutableNode(const std::string& section) {
+    std::shared_ptr<SectionNode>& node = this->mutableData()[section];
+
+    if(!node)
+        node = std::make_shared<SectionNode>();
+    else {
+        this->materialize(*node);
+        if(node.use_count() > 1)
+            node = std::make_shared<SectionNode>(*node);
+
+        node->pending.reset();
+    }
+
+    node->sourceHash = 0;
+    return *node;
+}
+
+std::vector<sConfParser::KeySpan>& sConfParser::mutableSpans(SectionNode& node) {
+    if(!node.spans)
+        node.spans = std::make_shared<SpanTable>();
+    else if(node.spans.use_count() > 1 || node.spans->sorted) {
+        auto copy = std::make_shared<SpanTable>();
+        copy->entries = node.spans->entries;
+        node.spans = std::move(copy);
+    }
+
+    return node.spans->entries;
+}
+
+const sConfParser::KeySpan* sConfParser::findSpan(const SectionNode& node, const std::string& key) {
+    if(!node.spans)
+        return nullptr;
+
+    SpanTable& spans = *node.spans;
+    std::call_once(spans.sorting, [&]() {
+        std::stable_sort(
+            spans.entries.begin(),
+            spans.entries.end(),
+            [](const KeySpan& a, const KeySpan& b) {
+                return a.keyHash < b.keyHash;
+            }
+        );
+        spans.sorted = true;
+    });
+
+    std::uint64_t hash = sConfHash::hash64(key.data(), key.size());
+    auto it = std::upper_bound(
+        spans.entries.begin(),
+        spans.entries.end(),
+        hash,
+        [](std::uint64_t value, const KeySpan& span) {
+            return value < span.keyHash;
+        }
+    );
+
+    if(it == spans.entries.begin() || (it - 1)->keyHash != hash)
+        return nullptr;
+
+    return &*(it - 1);
+}
+
+std::optional<sConfLocation> sConfParser::toLocation(
+    const SourcePosition& position,
+    std::uint32_t valueColumn
+) {
+    if(position.line == 0)
+        return std::nullopt;
+
+    return sConfLocation{sourceName(position.file), position.line, position.column, valueColumn};
+}
+
+std::string sConfParser::where(const std::string& section, const std::string& key) const {
+    std::optional<sConfLocation> location = this->locate(section, key);
+    return location ? location->toString() + ": " : "";
+}
+
+sConfParser::SectionTable& sConfParser::mutableData() {
+    if(!this->data)
+        this->data = std::make_shared<SectionTable>();
+    else if(this->data.use_count() > 1)
+        this->data = std::make_shared<SectionTable>(*this->data);
+
+    return *this->data;
+}
+
+sConfParser::CommentTable& sConfParser::mutableComments() {
+    if(!this->comments)
+        this->comments = std::make_shared<CommentTable>();
+    else if(this->comments.use_count() > 1)
+        this->comments = std::make_shared<CommentTable>(*this->comments);
+
+    return *this->comments;
+}
+
+sConfInterpolation& sConfParser::mutableInterpolation() {
+    if(!this->interpolation)
+        this->interpolation = std::make_shared<sConfInterpolation>();
+    else if(this->interpolation.use_count() > 1)
+        this->interpolation = std::make_shared<sConfInterpolation>(*this->interpolation);
+
+    return *this->interpolation;
+}
+
+void sConfParser::expandTemplates(
+    const sConfInterpolation& graph,
+    const std::vector<sConfInterpolation::Key>& order,
+    Expansion& updates
+) const {
+    std::unordered_map<std::string, size_t> expanded;
+    for(size_t i = 0; i < updates.size(); ++i)
+        expanded[updates[i].first.section + '\0' + updates[i].first.key] = i;
+
+    auto lookup = [&](const sConfInterpolation::Key& target) -> const sConfValue& {
+        auto update = expanded.find(target.section + '\0' + target.key);
+        if(update != expanded.end())
+            return updates[update->second].second;
+
+        const Section* section = this->findSection(target.section);
+        if(section) {
+            auto it = section->find(target.key);
+            if(it != section->end())
+                return it->second;
+        }
+
+        throw SconfException("Undefined reference: ${" + target.section + "." + target.key + "}");
+    };
+
+    auto environment = [](const std::string& name) -> std::string {
+        const char* value = std::getenv(name.c_str());
+        if(!value)
+            throw SconfException("Undefined environment variable: " + name);
+
+        return value;
+    };
+
+    auto resolve = [&](const sConfInterpolation::Reference& reference) {
+        return reference.environment ?
+            environment(reference.target.key) :
+            lookup(reference.target).toString();
+    };
+
+    for(const auto& target : order) {
+        const std::string& text = *graph.find(target);
+        sConfInterpolation::Reference whole;
+        sConfValue value;
+
+        try {
+            if(!sConfInterpolation::isWholeReference(text, whole))
+                value = this->inferTypes ?
+                    sConfValue(sConfInterpolation::expand(text, resolve)) :
+                    sConfValue::fromText(sConfInterpolation::expand(text, resolve));
+            else if(whole.environment)
+                value = this->inferTypes ?
+                    sConfValue::fromRaw(environment(whole.target.key)) :
+                    sConfValue::fromText(environment(whole.target.key));
+            else value = lookup(whole.target);
+        }
+        catch(const SconfException& error) {
+            throw SconfException(this->where(target.section, target.key) + error.what());
+        }
+
+        expanded[target.section + '\0' + target.key] = updates.size();
+        updates.emplace_back(target, std::move(value));
+    }
+}
+
+sConfParser::Expansion sConfParser::interpolateKey(
+    const std::string& section,
+    const std::string& key,
+    const sConfValue& value
+) {
+    sConfInterpolation& graph = this->mutableInterpolation();
+    sConfInterpolation::Key target{section, key};
+
+    const std::string* current = graph.find(target);
+    bool hadTemplate = current != nullptr;
+    std::string previous = hadTemplate ? *current : std::string();
+
+    Expansion updates;
+    if(value.getType() == sConfValue::Type::String && sConfInterpolation::isTemplate(value.getString()))
+        graph.set(target, value.getString());
+    else {
+        graph.erase(target);
+        updates.emplace_back(target, value);
+    }
+
+    try {
+        this->expandTemplates(graph, graph.dependents(target), updates);
+    }
+    catch(...) {
+        if(hadTemplate)
+            graph.set(target, previous);
+        else graph.erase(target);
+
+        throw;
+    }
+
+    return updates;
+}
+
+bool sConfParser::mayHoldTemplates(const PendingSection& pending) {
+    std::string_view source = *pending.source;
+
+    for(const auto& [begin, end] : pending.ranges)
+        if(source.substr(begin, end - begin).find("${") != std::string_view::npos)
+            return true;
+
+    return false;
+}
+
+void sConfParser::interpolate() {
+    sConfInterpolation graph = this->interpolation ?
+        *this->interpolation : sConfInterpolation();
+
+    if(this->data)
+        for(const auto& [section, node] : *this->data) {
+            if(node->pending && !mayHoldTemplates(*node->pending))
+                continue;
+
+            // Keys already in the graph hold an expansion, which may
+            // contain a literal `${` produced by `$${`; only values loaded
+            // or set since the last call are templates to register.
+            for(const auto& [key, value] : this->materialize(*node))
+                if(value.getType() == sConfValue::Type::String &&
+                    !graph.find({section, key}) &&
+                    sConfInterpolation::isTemplate(value.getString()))
+                    graph.set({section, key}, value.getString());
+        }
+
+    Expansion updates;
+    this->expandTemplates(graph, graph.order(), updates);
+
+    this->interpolation = std::make_shared<sConfInterpolation>(std::move(graph));
+    for(auto& [target, value] : updates)
+        this->mutableSection(target.section)[target.key] = std::move(value);
+}
+
+void sConfParser::saveValue(std::ofstream& file, const sConfValue& value) {
+    switch(value.getType()) {
+        case sConfValue::Type::Array: {
+            std::vector<sConfValue> elements = value.getArray();
+
+            file << "[";
+            for(size_t i = 0; i < elements.size(); ++i) {
+                saveValue(file, elements[i]);
+                if(i < elements.size() - 1)
+                    file << ", ";
+            }
+            file << "]";
+            break;
+        }
+
+        case sConfValue::Type::String:
+            if(value.getInferredType() != sConfValue::Type::String)
+                file << value.getString();
+            else if(sConfValue::fromRaw(value.getString()).getType() != sConfValue::Type::String)
+                file << '"' << value.getString() << '"';
+            else file << value.getString();
+            break;
+
+        case sConfValue::Type::Integer:
+        case sConfValue::Type::Double:
+            file << value.toString();
+            break;
+
+        case sConfValue::Type::Boolean:
+            file << (value.getBoolean() ? "true" : "false");
+            break;
+
+        case sConfValue::Type::Date:
+            file << sConfDate::format(value.getTimePoint().time_since_epoch().count());
+            break;
+
+        case sConfValue::Type::Duration:
+            file << sConfUnits::formatDuration(value.getDuration().count());
+            break;
+
+        case sConfValue::Type::Size:
+            file << sConfUnits::formatSize(value.getSize());
+            break;
+
+        default:
+            throw SconfException("Unsupported value type");
+    }
+}
+
+void sConfParser::load(const std::string& filename) {
+    this->load(filename, sConfLoadOptions());
+}
+
+void sConfParser::load(const std::string& filename, const sConfLoadOptions& options) {
+    sConfParser own;
+    std::vector<std::string> includes;
+
+    own.inferTypes = options.inferTypes;
+
+    if(options.lazySections)
+        includes = own.loadLazy(filename, options.lazyValues);
+    else {
+        SectionHashes hashes(&own);
+        Loader loader(own, &hashes, nullptr, options.lazyValues);
+        loader.allowIncludes(filename);
+
+        sConfEventParser events(loader, &own.statsRecorder);
+        hashes.events = &events;
+        loader.track(events, internSource(filename));
+
+        events.parseFile(filename);
+        own.adoptHashes(hashes);
+        includes = loader.includedFiles();
+    }
+
+    this->commitLoad(own, filename, includes, options);
+}
+
+void sConfParser::commitLoad(
+    const sConfParser& loaded,
+    const std::string& filename,
+    const std::vector<std::string>& includes,
+    const sConfLoadOptions& options
+) {
+    sConfParser expanded;
+    expanded.inferTypes = options.inferTypes;
+    std::vector<std::string> chain{resolveInclude(filename, "")};
+
+    for(const auto& include : includes)
+        expanded.applyInclude(include, chain);
+    expanded.merge(loaded);
+
+    this->mergeLoaded(expanded, options);
+    this->statsRecorder.absorb(loaded.statsRecorder);
+}
+
+void sConfParser::mergeLoaded(const sConfParser& loaded, const sConfLoadOptions& options) {
+    sConfParser next;
+    next.data = this->data;
+    next.comments = this->comments;
+    next.interpolation = this->interpolation;
+    next.inferTypes = options.inferTypes;
+
+    next.merge(loaded);
+    if(options.interpolate)
+        next.interpolate();
+
+    this->data = std::move(next.data);
+    this->comments = std::move(next.comments);
+    this->interpolation = std::move(next.interpolation);
+    this->inferTypes = options.inferTypes;
+}
+
+std::vector<sConfDiagnostic> sConfParser::tryLoad(
+    const std::string& filename,
+    const sConfLoadOptions& options
+) {
+    std::vector<sConfDiagnostic> errors;
+    auto full = [&]() {
+        return options.maxErrors != 0 && errors.size() >= options.maxErrors;
+    };
+
+    std::ifstream file(filename);
+    if(!file) {
+        errors.push_back({sConfDiagnostic::Kind::OpenFailed, filename, 0, 0, "Failed to open file: " + filename});
+        return errors;
+    }
+
+    sConfParser own;
+    own.inferTypes = options.inferTypes;
+    this->inferTypes = options.inferTypes;
+
+    SectionHashes hashes(&own);
+    Loader loader(own, &hashes, nullptr, options.lazyValues);
+    loader.allowIncludes(filename);
+    loader.collect(errors, options.maxErrors);
+
+    sConfEventParser events(loader, &own.statsRecorder);
+    hashes.events = &events;
+    loader.track(events, internSource(filename));
+
+    events.setPosition(filename, 0);
+    events.parse(file);
+    own.adoptHashes(hashes);
+
+    std::vector<std::string> chain{resolveInclude(filename, "")};
+    for(const auto& include : loader.includedFiles()) {
+        if(full())
+            break;
+
+        try {
+            this->applyInclude(include, chain);
+        }
+        catch(const std::exception& error) {
+            errors.push_back({sConfDiagnostic::Kind::IncludeFailed, filename, 0, 0, error.what()});
+            chain.resize(1);
+        }
+    }
+
+    this->merge(own);
+    this->statsRecorder.absorb(own.statsRecorder);
+
+    if(options.interpolate && !full())
+        try {
+            this->interpolate();
+        }
+        catch(const std::exception& error) {
+            errors.push_back({sConfDiagnostic::Kind::InterpolationFailed, filename, 0, 0, error.what()});
+        }
+
+    return errors;
+}
+
+struct sConfParser::Stream::State {
+    explicit State(const sConfLoadOptions& options) :
+        own(),
+        loader(own, nullptr, nullptr, options.lazyValues),
+        events(loader, &own.statsRecorder) {
+        this->own.inferTypes = options.inferTypes;
+    }
+
+    sConfParser own;
+    Loader loader;
+    sConfEventParser events;
+};
+
+sConfParser::Stream::Stream(
+    sConfParser& document,
+    const std::string& name,
+    const sConfLoadOptions& options
+) :
+    document(document),
+    options(options),
+    state(std::make_unique<State>(options)) {
+    if(!name.empty())
+        this->state->loader.allowIncludes(name);
+
+    this->state->events.setPosition(name, 0);
+    this->state->loader.track(this->state->events, internSource(name));
+}
+
+sConfParser::Stream::~Stream() = default;
+
+void sConfParser::Stream::feed(const char* data, std::size_t size) {
+    if(!this->state)
+        throw SconfException("Stream already finished");
+
+    this->state->events.feed(data, size);
+}
+
+void sConfParser::Stream::finish() {
+    if(!this->state)
+        throw SconfException("Stream already finished");
+
+    std::unique_ptr<State> state = std::move(this->state);
+    state->events.finish();
+
+    this->document.commitLoad(
+        state->own,
+        state->events.getSource(),
+        state->loader.includedFiles(),
+        this->options
+    );
+}
+
+void sConfParser::clearIncludeCache() {
+    IncludeCache::instance().clear();
+}
+
+std::shared_ptr<const sConfParser::IncludedFile> sConfParser::parseIncluded(const std::string& path, bool inferTypes) {
+    auto document = std::make_shared<sConfParser>();
+    document->inferTypes = inferTypes;
+    Loader loader(*document, nullptr, nullptr, false);
+    loader.allowIncludes(path);
+
+    sConfEventParser events(loader);
+    loader.track(events, internSource(path));
+    events.parseFile(path);
+
+    auto file = std::make_shared<IncludedFile>();
+    file->document = document;
+    file->includes = loader.includedFiles();
+
+    return file;
+}
+
+std::string sConfParser::resolveInclude(const std::string& from, const std::string& path) {
+    std::filesystem::path target = std::filesystem::path(from).parent_path() / path;
+    if(path.empty())
+        target = from;
+    else if(std::filesystem::path(path).is_absolute())
+        target = path;
+
+    std::error_code error;
+    std::filesystem::path resolved = std::filesystem::weakly_canonical(target, error);
+
+    return (error ? target.lexically_normal() : resolved).string();
+}
+
+void sConfParser::applyInclude(const std::string& path, std::vector<std::string>& chain) {
+    if(std::find(chain.begin(), chain.end(), path) != chain.end()) {
+        std::string cycle;
+        for(const auto& file : chain)
+            cycle += file + " -> ";
+
+        throw SconfException("Include cycle: " + cycle + path);
+    }
+
+    std::shared_ptr<const IncludedFile> file = IncludeCache::instance().request(path, this->inferTypes).get();
 
-std::string sConfParser::trimQuotes(const std::string& str) {
-    if(str.size() >= 2 && str.front() == '"' && str.back() == '"')
-        return str.substr(1, str.size() - 2);
-    return str;
-}
+    chain.push_back(path);
+    for(const auto& include : file->includes)
+        this->applyInclude(include, chain);
+    chain.pop_back();
 
-std::string sConfParser::formatDateTime(const std::tm& time) {
-    std::ostringstream oss;
-    oss << std::put_time(&time, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+    this->merge(*file->document);
 }
 
-bool sConfParser::isArray(const std::string& value) {
-    return !value.empty() && value.front() == '[' && value.back() == ']';
-}
+void sConfParser::loadAll(
+    const std::vector<std::string>& filenames,
+    const sConfLoadOptions& options
+) {
+    std::vector<sConfParser> parts(filenames.size());
+    std::vector<std::exception_ptr> errors(filenames.size());
+    std::atomic<size_t> next(0);
+
+    sConfLoadOptions partOptions = options;
+    partOptions.interpolate = false;
+
+    auto work = [&]() {
+        for(size_t i = next++; i < filenames.size(); i = next++)
+            try {
+                parts[i].load(filenames[i], partOptions);
+            }
+            catch(...) {
+                errors[i] = std::current_exception();
+            }
+    };
 
-std::vector<sConfValue> sConfParser::parseArray(const std::string& value) {
-    std::vector<sConfValue> result;
-    std::string inner = value.substr(1, value.size() - 2);
-    std::istringstream stream(inner);
-    std::string item;
+    size_t workers = std::min<size_t>(
+        filenames.size(),
+        std::max(1u, std::thread::hardware_concurrency())
+    );
 
-    while(std::getline(stream, item, ',')) {
-        std::string trimmed = trimQuotes(trim(item));
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
 
-        if(isArray(trimmed))
-            result.emplace_back(parseArray(trimmed));
-        else result.emplace_back(sConfValue(trimmed));
-    }
+    for(size_t i = 1; i < workers; ++i)
+        try {
+            threads.emplace_back(work);
+        }
+        catch(...) {
+            // The workers already started reference this frame, so do not
+            // unwind past them: run the remaining files on the threads
+            // there are, this one included.
+            break;
+        }
+
+    work();
+    for(auto& thread : threads)
+        thread.join();
+
+    for(const auto& error : errors)
+        if(error)
+            std::rethrow_exception(error);
 
-    return result;
+    sConfParser combined;
+    for(const auto& part : parts)
+        combined.merge(part);
+
+    this->mergeLoaded(combined, options);
+    for(const auto& part : parts)
+        this->statsRecorder.absorb(part.statsRecorder);
 }
 
-void sConfParser::parseLine(
-    const std::string& line,
-    std::string& currentSection,
-    std::vector<std::string>& commentBuffer
+void sConfParser::loadDirectory(
+    const std::string& directory,
+    const std::string& pattern,
+    const sConfLoadOptions& options
 ) {
-    std::string trimmed = trim(line);
-    if(trimmed.empty())
-        return;
+    std::vector<std::string> filenames;
+    std::error_code error;
+
+    for(std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+        if(it->is_regular_file(error) && sConfGlob::match(pattern, it->path().filename().string()))
+            filenames.push_back(it->path().string());
+
+    if(error)
+        throw SconfException("Failed to read directory: " + directory + ": " + error.message());
 
-    if(trimmed[0] == ';') {
-        commentBuffer.push_back(trim(trimmed.substr(1)));
+    std::sort(filenames.begin(), filenames.end());
+    this->loadAll(filenames, options);
+}
+
+void sConfParser::merge(const sConfParser& other) {
+    if(this == &other)
         return;
-    }
 
-    if(trimmed[0] == '[' && trimmed.back() == ']') {
-        currentSection = trimQuotes(trim(trimmed.substr(1, trimmed.size() - 2)));
-        if(this->comments.find(currentSection) == this->comments.end())
-            this->comments[currentSection] = {};
+    if(other.data && !other.data->empty()) {
+        if(!this->data || this->data->empty())
+            this->data = other.data;
+        else for(const auto& [section, node] : *other.data) {
+            SectionTable& table = this->mutableData();
+            auto it = table.find(section);
 
-        this->comments[currentSection].insert(
-            this->comments[currentSection].end(),
-            commentBuffer.begin(),
-            commentBuffer.end()
-        );
-    }
-    else {
-        size_t eqPos = trimmed.find('=');
-        if(eqPos == std::string::npos)
-            throw SconfException("Invalid key-value pair: " + line);
+            if(it == table.end()) {
+                table.emplace(section, node);
+                continue;
+            }
+
+            const Section& incoming = other.materialize(*node);
+            SectionNode& target = this->mutableNode(section);
 
-        std::string key = trimQuotes(trim(trimmed.substr(0, eqPos)));
-        std::string value = trim(trimmed.substr(eqPos + 1));
+            if(target.header.line == 0)
+                target.header = node->header;
 
-        size_t commentPos = value.find(';');
-        if(commentPos != std::string::npos)
-            value = trimQuotes(trim(value.substr(0, commentPos)));
+            if(node->spans) {
+                findSpan(*node, "");
 
-        sConfValue sValue;
-        if(this->isArray(value))
-            sValue = sConfValue(parseArray(value));
-        else sValue = sConfValue(trimQuotes(value));
+                const std::vector<KeySpan>& spans = node->spans->entries;
+                std::vector<KeySpan>& targetSpans = mutableSpans(target);
+                targetSpans.insert(targetSpans.end(), spans.begin(), spans.end());
+            }
+
+            for(const auto& [key, value] : incoming) {
+                target.pairs.insert_or_assign(key, value);
+
+                if(this->interpolation && this->interpolation->find({section, key}))
+                    this->mutableInterpolation().erase({section, key});
+            }
+        }
+    }
 
-        this->data[currentSection][key] = sValue;
+    if(other.interpolation) {
+        if(!this->interpolation || this->interpolation->empty())
+            this->interpolation = other.interpolation;
+        else for(const auto& key : other.interpolation->keys())
+            this->mutableInterpolation().set(key, *other.interpolation->find(key));
     }
 
-    commentBuffer.clear();
-}
+    if(other.comments && !other.comments->empty()) {
+        if(!this->comments || this->comments->empty())
+            this->comments = other.comments;
+        else {
+            CommentTable& table = this->mutableComments();
 
-void sConfParser::saveValue(std::ofstream& file, const sConfValue& value) {
-    switch(value.getType()) {
-        case sConfValue::Type::Array:
-            file << "[";
-            for(size_t i = 0; i < value.getArray().size(); ++i) {
-                saveValue(file, value.getArray()[i]);
-                if(i < value.getArray().size() - 1)
-                    file << ", ";
+            for(const auto& [section, lines] : *other.comments) {
+                std::vector<std::string>& target = table[section];
+                target.insert(target.end(), lines.begin(), lines.end());
             }
-            file << "]";
-            break;
+        }
+    }
+}
 
-        case sConfValue::Type::String:
-            file << value.getString();
-            break;
+std::vector<std::string> sConfParser::loadLazy(const std::string& filename, bool deferValues) {
+    std::ifstream file(filename, std::ios::binary);
+    if(!file)
+        throw SconfException("Failed to open file: " + filename);
 
-        case sConfValue::Type::Integer:
-            file << value.getInteger();
-            break;
+    file.seekg(0, std::ios::end);
+    auto source = std::make_shared<std::string>(static_cast<size_t>(file.tellg()), '\0');
 
-        case sConfValue::Type::Double:
-            file << value.getDouble();
-            break;
+    file.seekg(0, std::ios::beg);
+    if(!file.read(&(*source)[0], static_cast<std::streamsize>(source->size())))
+        throw SconfException("Failed to read file: " + filename);
+    const std::string& text = *source;
 
-        case sConfValue::Type::Boolean:
-            file << (value.getBoolean() ? "true" : "false");
-            break;
+    Loader directives(*this, nullptr, nullptr, deferValues);
+    sConfEventParser directiveParser(directives);
+    directives.allowIncludes(filename);
 
-        case sConfValue::Type::Date:
-            file << sConfParser::formatDateTime(value.getDate());
-            break;
+    std::uint32_t fileId = internSource(filename);
+    directives.track(directiveParser, fileId);
 
-        default:
-            throw SconfException("Unsupported value type");
+    std::unordered_map<std::string, std::shared_ptr<PendingSection>> pending;
+    std::unordered_map<std::string, SourcePosition> headers;
+    std::vector<std::string> commentBuffer;
+    std::string currentSection;
+    size_t rangeStart = 0, lineNumber = 0;
+    std::uint32_t rangeLine = 1;
+    bool rangeHasPairs = false;
+
+    auto closeRange = [&](size_t end) {
+        if(!rangeHasPairs)
+            return;
+
+        std::shared_ptr<PendingSection>& entry = pending[currentSection];
+        if(!entry) {
+            entry = std::make_shared<PendingSection>();
+            entry->source = source;
+            entry->file = fileId;
+            entry->deferValues = deferValues;
+            entry->inferTypes = this->inferTypes;
+        }
+
+        entry->ranges.emplace_back(rangeStart, end);
+        entry->lines.push_back(rangeLine);
+    };
+
+    auto mark = sConfStatsRecorder::now();
+    for(size_t start = 0; start < text.size();) {
+        size_t end = text.find('\n', start);
+        if(end == std::string::npos)
+            end = text.size();
+        this->statsRecorder.line(end - start + 1);
+        ++lineNumber;
+
+        size_t first = start;
+        while(first < end && std::isspace(static_cast<unsigned char>(text[first])))
+            ++first;
+
+        size_t last = end;
+        while(last > first && std::isspace(static_cast<unsigned char>(text[last - 1])))
+            --last;
+
+        if(first == last) {
+            start = end + 1;
+            continue;
+        }
+
+        if(text[first] == ';')
+            commentBuffer.push_back(trim(text.substr(first + 1, last - first - 1)));
+        else if(text[first] == '@') {
+            directiveParser.setPosition(filename, lineNumber - 1);
+            directiveParser.parseLine(text.substr(first, last - first));
+            commentBuffer.clear();
+        }
+        else if(text[first] == '[' && text[last - 1] == ']') {
+            closeRange(start);
+
+            currentSection = trimQuotes(trim(text.substr(first + 1, last - first - 2)));
+            headers.try_emplace(currentSection, SourcePosition{fileId, narrow(lineNumber), narrow(first - start + 1)});
+            std::vector<std::string>& sectionComments = this->mutableComments()[currentSection];
+            sectionComments.insert(
+                sectionComments.end(),
+                commentBuffer.begin(),
+                commentBuffer.end()
+            );
+
+            commentBuffer.clear();
+            rangeStart = end + 1;
+            rangeLine = narrow(lineNumber + 1);
+            rangeHasPairs = false;
+        }
+        else {
+            commentBuffer.clear();
+            rangeHasPairs = true;
+        }
+
+        start = end + 1;
+    }
+
+    closeRange(text.size());
+    this->statsRecorder.lap(sConfStats::Scan, mark);
+
+    for(auto& [section, entry] : pending) {
+        SectionNode& node = this->mutableNode(section);
+        node.header = headers[section];
+        node.pending = std::move(entry);
     }
+
+    return directives.includedFiles();
 }
 
-void sConfParser::load(const std::string& filename) {
-    std::ifstream file(filename);
+sConfDiff sConfParser::reload(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
     if(!file)
         throw SconfException("Failed to open file: " + filename);
 
-    std::string line;
-    std::string currentSection;
-    std::vector<std::string> commentBuffer;
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    SectionHashes hashes(nullptr);
+    sConfEventParser scanner(hashes);
+    hashes.events = &scanner;
+    scanner.parse(contents);
+
+    SectionTable reused;
+    std::vector<std::pair<std::string, std::int64_t>> moved;
+    if(this->data)
+        for(const auto& [section, entry] : hashes.entries) {
+            auto it = this->data->find(section);
+            if(it == this->data->end() ||
+                it->second->sourceHash == 0 ||
+                it->second->sourceHash != entry.hash ||
+                it->second->sourceLayout != entry.layout)
+                continue;
+
+            reused[section] = it->second;
+            if(entry.line != it->second->sourceLine)
+                moved.emplace_back(
+                    section,
+                    static_cast<std::int64_t>(entry.line) - it->second->sourceLine
+                );
+        }
+
+    contents.clear();
+    contents.seekg(0);
+
+    sConfParser next;
+    next.inferTypes = this->inferTypes;
+    Loader loader(next, nullptr, &reused, false);
+    loader.allowIncludes(filename);
+
+    sConfEventParser events(loader, &this->statsRecorder);
+    events.setPosition(filename, 0);
+    loader.track(events, internSource(filename));
+    events.parse(contents);
+
+    for(auto& [section, entry] : hashes.entries)
+        entry.created = reused.find(section) == reused.end();
+    next.adoptHashes(hashes);
+
+    for(const auto& [section, node] : reused) {
+        next.mutableData()[section] = node;
+
+        if(this->comments) {
+            auto it = this->comments->find(section);
+            if(it != this->comments->end())
+                next.mutableComments()[section] = it->second;
+        }
+    }
+
+    if(!loader.includedFiles().empty()) {
+        sConfParser expanded;
+        expanded.inferTypes = this->inferTypes;
+        std::vector<std::string> chain{resolveInclude(filename, "")};
+
+        for(const auto& include : loader.includedFiles())
+            expanded.applyInclude(include, chain);
+
+        expanded.merge(next);
+        next.data = expanded.data;
+        next.comments = expanded.comments;
+    }
+
+    if(this->interpolation)
+        next.interpolate();
+
+    sConfDiff diff;
+    if(this->data)
+        for(const auto& [section, node] : *this->data)
+            if(!next.findSection(section)) {
+                diff.addSectionChange(sConfChange::Kind::Removed, section);
+                diffSection(diff, section, &this->materialize(*node), nullptr);
+            }
+
+    for(const auto& [section, node] : *next.data) {
+        const Section* before = this->findSection(section);
+
+        if(!before) {
+            diff.addSectionChange(sConfChange::Kind::Added, section);
+            diffSection(diff, section, nullptr, &next.materialize(*node));
+        }
+        else if(before != &next.materialize(*node)) {
+            bool keysChanged = diffSection(diff, section, before, &node->pairs);
+            bool commentsChanged = this->sectionHasComments(section) != next.sectionHasComments(section) ||
+                (next.sectionHasComments(section) &&
+                    this->comments->at(section) != next.comments->at(section));
+
+            if(keysChanged || commentsChanged)
+                diff.addSectionChange(sConfChange::Kind::Modified, section);
+        }
+    }
+
+    this->data = std::move(next.data);
+    this->comments = next.comments;
+    this->interpolation = next.interpolation;
+    reused.clear();
+
+    // Sections reused from further up or down the file keep their content
+    // but not their line numbers. Their nodes are moved once the old
+    // document is released, cloning those still shared with copies.
+    for(const auto& [section, delta] : moved) {
+        std::shared_ptr<SectionNode>& node = this->mutableData()[section];
+        if(node.use_count() > 1)
+            node = std::make_shared<SectionNode>(*node);
 
-    while(std::getline(file, line))
-        this->parseLine(line, currentSection, commentBuffer);
+        shiftLines(*node, delta);
+    }
+
+    this->subscriptions.dispatch(diff);
+    return diff;
 }
 
 void sConfParser::save(const std::string& filename) const {
@@ -170,43 +1552,58 @@ void sConfParser::save(const std::string& filename) const {
     if(!file)
         throw SconfException("Failed to open file for writing: " + filename);
 
-    for(const auto& [section, keys] : this->data) {
-        if(this->comments.find(section) != this->comments.end())
-            for(const auto& comment : this->comments.at(section))
-                file << "; " << comment << '\n';
+    auto start = sConfStatsRecorder::now();
+    if(this->data)
+        for(const auto& [section, node] : *this->data) {
+            if(this->sectionHasComments(section))
+                for(const auto& comment : this->comments->at(section))
+                    file << "; " << comment << '\n';
 
-        file << "[" << section << "]\n";
-        for(const auto& [key, value] : keys) {
-            file << key << " = ";
-            saveValue(file, value);
-            file << "\n";
+            file << "[" << section << "]\n";
+            for(const auto& [key, value] : this->materialize(*node)) {
+                const std::string* text = this->interpolation ?
+                    this->interpolation->find({section, key}) : nullptr;
+
+                file << key << " = ";
+                saveValue(file, text ? sConfValue(*text) : value);
+                file << "\n";
+            }
         }
-    }
+
+    this->statsRecorder.save(start);
 }
 
 std::vector<std::string> sConfParser::getSections() const {
     std::vector<std::string> sections;
-    sections.reserve(this->data.size());
+    if(!this->data)
+        return sections;
 
-    for(const auto& [section, _] : this->data)
+    sections.reserve(this->data->size());
+    for(const auto& [section, _] : *this->data)
         sections.push_back(section);
     return sections;
 }
 
-std::unordered_map<std::string, sConfValue> sConfParser::getSection(
+sConfParser::Section sConfParser::getSection(
     const std::string& section
 ) const {
-    auto it = this->data.find(trimQuotes(trim(section)));
-    if(it != this->data.end())
-        return it->second;
+    const Section* sectionData = this->findSection(trimQuotes(trim(section)));
+
+    this->statsRecorder.lookup(sConfStats::GetSection, sectionData != nullptr);
+    if(sectionData)
+        return *sectionData;
 
     throw SconfException("Section not found: " + section);
 }
 
 void sConfParser::addSection(const std::string& section) {
     std::string sectionName = trimQuotes(trim(section));
-    if(this->data.find(sectionName) == this->data.end())
-        this->data[sectionName] = {};
+    if(this->findSection(sectionName))
+        return;
+
+    this->mutableSection(sectionName);
+    if(this->subscriptions.isWatched(sectionName))
+        this->subscriptions.dispatch({{sConfChange::Kind::Added, sectionName, ""}});
 }
 
 void sConfParser::setKey(
@@ -217,29 +1614,102 @@ void sConfParser::setKey(
     std::string sectionName = trimQuotes(trim(section)),
         keyName = trimQuotes(trim(key));
 
-    if(this->data.find(sectionName) == this->data.end())
+    const Section* sectionData = this->findSection(sectionName);
+    if(!sectionData)
         throw SconfException("Section not found: " + section);
-    this->data[sectionName][keyName] = value;
+
+    if(this->interpolation) {
+        this->setKeys(this->interpolateKey(sectionName, keyName, value));
+        return;
+    }
+
+    if(!this->subscriptions.isWatched(sectionName)) {
+        this->mutableSection(sectionName)[keyName] = value;
+        return;
+    }
+
+    auto existing = sectionData->find(keyName);
+    if(existing != sectionData->end() && existing->second == value)
+        return;
+
+    sConfChange::Kind kind = existing == sectionData->end() ?
+        sConfChange::Kind::Added : sConfChange::Kind::Modified;
+
+    this->mutableSection(sectionName)[keyName] = value;
+    this->subscriptions.dispatch({
+        {sConfChange::Kind::Modified, sectionName, ""},
+        {kind, sectionName, keyName}
+    });
+}
+
+void sConfParser::setKeys(Expansion updates) {
+    std::vector<sConfChange> changes;
+    std::unordered_set<std::string> modified;
+
+    for(auto& [target, value] : updates) {
+        if(!this->subscriptions.isWatched(target.section)) {
+            this->mutableSection(target.section)[target.key] = std::move(value);
+            continue;
+        }
+
+        const Section* sectionData = this->findSection(target.section);
+        auto existing = sectionData ? sectionData->find(target.key) : Section::const_iterator();
+        bool found = sectionData && existing != sectionData->end();
+
+        if(found && existing->second == value)
+            continue;
+
+        this->mutableSection(target.section)[target.key] = std::move(value);
+        if(modified.insert(target.section).second)
+            changes.push_back({sConfChange::Kind::Modified, target.section, ""});
+
+        changes.push_back({
+            found ? sConfChange::Kind::Modified : sConfChange::Kind::Added,
+            target.section,
+            target.key
+        });
+    }
+
+    this->subscriptions.dispatch(changes);
 }
 
 void sConfParser::removeSection(const std::string& section) {
     std::string sectionName = trimQuotes(section);
-    if(this->data.erase(sectionName) == 0)
+    const Section* sectionData = this->findSection(sectionName);
+    if(!sectionData)
         throw SconfException("Section not found: " + section);
 
-    this->comments.erase(sectionName);
+    std::vector<sConfChange> changes;
+    if(this->subscriptions.isWatched(sectionName)) {
+        changes.push_back({sConfChange::Kind::Removed, sectionName, ""});
+        for(const auto& [key, _] : *sectionData)
+            changes.push_back({sConfChange::Kind::Removed, sectionName, key});
+    }
+
+    this->mutableData().erase(sectionName);
+    if(this->comments && this->comments->find(sectionName) != this->comments->end())
+        this->mutableComments().erase(sectionName);
+    if(this->interpolation && !this->interpolation->empty())
+        this->mutableInterpolation().eraseSection(sectionName);
+
+    this->subscriptions.dispatch(changes);
 }
 
 bool sConfParser::hasSection(const std::string& section) const {
-    return this->data.find(trimQuotes(trim(section))) != this->data.end();
+    bool found = this->data && this->data->find(trimQuotes(trim(section))) != this->data->end();
+
+    this->statsRecorder.lookup(sConfStats::HasSection, found);
+    return found;
 }
 
-std::unordered_map<std::string, sConfValue> sConfParser::getSectionKeyPair(
+sConfParser::Section sConfParser::getSectionKeyPair(
     const std::string& section
 ) const {
-    auto it = this->data.find(trimQuotes(trim(section)));
-    if(it != this->data.end())
-        return it->second;
+    const Section* sectionData = this->findSection(trimQuotes(trim(section)));
+
+    this->statsRecorder.lookup(sConfStats::GetSectionKeyPair, sectionData != nullptr);
+    if(sectionData)
+        return *sectionData;
 
     throw SconfException("Section not found: " + section);
 }
@@ -248,22 +1718,47 @@ bool sConfParser::hasSectionPairByKey(
     const std::string& section,
     const std::string& key
 ) const {
-    auto sectionIt = this->data.find(trimQuotes(trim(section)));
-    if(sectionIt == this->data.end())
-        return false;
+    const Section* sectionData = this->findSection(trimQuotes(trim(section)));
+    bool found = sectionData && sectionData->find(trimQuotes(trim(key))) != sectionData->end();
 
-    return sectionIt->second.find(trimQuotes(trim(key))) != sectionIt->second.end();
+    this->statsRecorder.lookup(sConfStats::HasSectionPairByKey, found);
+    return found;
 }
 
 void sConfParser::removeSectionPairByKey(
     const std::string& section,
     const std::string& key
 ) {
-    std::string keyName = trimQuotes(trim(key));
+    std::string sectionName = trimQuotes(trim(section)),
+        keyName = trimQuotes(trim(key));
 
-    auto sectionIt = this->data.find(trimQuotes(trim(section)));
-    if(sectionIt == this->data.end() || sectionIt->second.erase(keyName) == 0)
+    const Section* sectionData = this->findSection(sectionName);
+    if(!sectionData || sectionData->find(keyName) == sectionData->end())
         throw SconfException("Key not found in section: " + keyName);
+
+    SectionNode& node = this->mutableNode(sectionName);
+    node.pairs.erase(keyName);
+
+    if(findSpan(node, keyName)) {
+        std::uint64_t hash = sConfHash::hash64(keyName.data(), keyName.size());
+        std::vector<KeySpan>& spans = mutableSpans(node);
+
+        spans.erase(
+            std::remove_if(spans.begin(), spans.end(), [hash](const KeySpan& span) {
+                return span.keyHash == hash;
+            }),
+            spans.end()
+        );
+    }
+
+    if(this->interpolation && this->interpolation->find({sectionName, keyName}))
+        this->mutableInterpolation().erase({sectionName, keyName});
+
+    if(this->subscriptions.isWatched(sectionName))
+        this->subscriptions.dispatch({
+            {sConfChange::Kind::Modified, sectionName, ""},
+            {sConfChange::Kind::Removed, sectionName, keyName}
+        });
 }
 
 bool sConfParser::isSectionPairArray(
@@ -273,12 +1768,16 @@ bool sConfParser::isSectionPairArray(
     std::string sectionName = trimQuotes(trim(section)),
         keyName = trimQuotes(trim(key));
 
-    auto sectionIt = this->data.find(sectionName);
-    if(sectionIt == this->data.end())
+    const Section* sectionData = this->findSection(sectionName);
+    if(!sectionData) {
+        this->statsRecorder.lookup(sConfStats::IsSectionPairArray, false);
         throw SconfException("Section not found: " + sectionName);
+    }
 
-    auto keyIt = sectionIt->second.find(keyName);
-    if(keyIt == sectionIt->second.end())
+    auto keyIt = sectionData->find(keyName);
+    this->statsRecorder.lookup(sConfStats::IsSectionPairArray, keyIt != sectionData->end());
+
+    if(keyIt == sectionData->end())
         throw SconfException("Key not found: " + keyName);
 
     return keyIt->second.isArray();
@@ -291,36 +1790,290 @@ bool sConfParser::isSectionPairSingleString(
     std::string sectionName = trimQuotes(trim(section)),
         keyName = trimQuotes(trim(key));
 
-    auto sectionIt = this->data.find(sectionName);
-    if(sectionIt == this->data.end())
+    const Section* sectionData = this->findSection(sectionName);
+    if(!sectionData) {
+        this->statsRecorder.lookup(sConfStats::IsSectionPairSingleString, false);
         throw SconfException("Section not found: " + sectionName);
+    }
 
-    auto keyIt = sectionIt->second.find(keyName);
-    if(keyIt == sectionIt->second.end())
+    auto keyIt = sectionData->find(keyName);
+    this->statsRecorder.lookup(sConfStats::IsSectionPairSingleString, keyIt != sectionData->end());
+
+    if(keyIt == sectionData->end())
         throw SconfException("Key not found: " + keyName);
 
     return !keyIt->second.isArray();
 }
 
+const sConfParser::Section* sConfParser::lookupSection(
+    const std::string& section,
+    sConfError& error
+) const noexcept {
+    try {
+        std::string_view view = sConfText::normalize(section);
+        std::string normalized;
+        const std::string& name = view.size() == section.size() ?
+            section : (normalized = view);
+
+        const Section* sectionData = this->findSection(name);
+        if(!sectionData)
+            error = sConfError::SectionNotFound;
+
+        return sectionData;
+    }
+    catch(...) {
+        error = sConfError::InvalidSection;
+        return nullptr;
+    }
+}
+
+const sConfValue* sConfParser::lookupValue(
+    const std::string& section,
+    const std::string& key,
+    sConfError& error
+) const noexcept {
+    const Section* sectionData = this->lookupSection(section, error);
+    if(!sectionData) {
+        this->statsRecorder.lookup(sConfStats::TryGet, false);
+        return nullptr;
+    }
+
+    std::string_view view = sConfText::normalize(key);
+    Section::const_iterator keyIt;
+
+    try {
+        std::string normalized;
+        keyIt = sectionData->find(view.size() == key.size() ? key : (normalized = view));
+    }
+    catch(...) {
+        keyIt = sectionData->end();
+    }
+    this->statsRecorder.lookup(sConfStats::TryGet, keyIt != sectionData->end());
+
+    if(keyIt == sectionData->end()) {
+        error = sConfError::KeyNotFound;
+        return nullptr;
+    }
+
+    return &keyIt->second;
+}
+
+const sConfParser::Section* sConfParser::find(const std::string& section) const noexcept {
+    sConfError error = sConfError::None;
+    const Section* sectionData = this->lookupSection(section, error);
+
+    this->statsRecorder.lookup(sConfStats::Find, sectionData != nullptr);
+    return sectionData;
+}
+
+const sConfValue* sConfParser::find(
+    const std::string& section,
+    const std::string& key
+) const noexcept {
+    sConfError error = sConfError::None;
+    return this->lookupValue(section, key, error);
+}
+
+std::string_view sConfParser::getOr(
+    const std::string& section,
+    const std::string& key,
+    const char* fallback
+) const noexcept {
+    return this->tryGet<std::string_view>(section, key).valueOr(fallback ? fallback : "");
+}
+
+std::optional<sConfLocation> sConfParser::locate(const std::string& section) const {
+    std::string sectionName = trimQuotes(trim(section));
+    if(!this->data)
+        return std::nullopt;
+
+    auto it = this->data->find(sectionName);
+    if(it == this->data->end())
+        return std::nullopt;
+
+    return toLocation(it->second->header, 0);
+}
+
+std::optional<sConfLocation> sConfParser::locate(
+    const std::string& section,
+    const std::string& key
+) const {
+    std::string sectionName = trimQuotes(trim(section)),
+        keyName = trimQuotes(trim(key));
+
+    if(!this->data)
+        return std::nullopt;
+
+    auto it = this->data->find(sectionName);
+    if(it == this->data->end())
+        return std::nullopt;
+
+    const Section& pairs = this->materialize(*it->second);
+    if(pairs.find(keyName) == pairs.end())
+        return std::nullopt;
+
+    const KeySpan* span = findSpan(*it->second, keyName);
+    if(!span)
+        return std::nullopt;
+
+    return toLocation(span->key, span->valueColumn);
+}
+
 std::vector<std::string> sConfParser::getSectionComment(
     const std::string& section
 ) const {
     std::string sectionName = trimQuotes(trim(section));
 
-    auto it = this->comments.find(sectionName);
-    if(it != this->comments.end())
-        return it->second;
+    if(this->comments) {
+        auto it = this->comments->find(sectionName);
+        if(it != this->comments->end()) {
+            this->statsRecorder.lookup(sConfStats::GetSectionComment, true);
+            return it->second;
+        }
+    }
+
+    this->statsRecorder.lookup(sConfStats::GetSectionComment, false);
 
     throw SconfException("Section not found: " + sectionName);
 }
 
 bool sConfParser::hasSectionComment(const std::string& section) const {
-    auto it = this->comments.find(trimQuotes(trim(section)));
-    return it != this->comments.end() && !it->second.empty();
+    bool found = this->sectionHasComments(trimQuotes(trim(section)));
+
+    this->statsRecorder.lookup(sConfStats::HasSectionComment, found);
+    return found;
+}
+
+bool sConfParser::sectionHasComments(const std::string& section) const {
+    if(!this->comments)
+        return false;
+
+    auto it = this->comments->find(section);
+    return it != this->comments->end() && !it->second.empty();
 }
 
 void sConfParser::removeSectionComment(const std::string& section) {
-    auto it = this->comments.find(trimQuotes(trim(section)));
-    if(it != this->comments.end())
-        it->second.clear();
+    std::string sectionName = trimQuotes(trim(section));
+    if(this->sectionHasComments(sectionName))
+        this->mutableComments()[sectionName].clear();
+}
+
+sConfSubscriptions::Id sConfParser::subscribe(
+    const std::string& section,
+    const std::string& key,
+    sConfSubscriptions::Callback callback
+) {
+    return this->subscriptions.subscribe(
+        trimQuotes(trim(section)),
+        trimQuotes(trim(key)),
+        std::move(callback)
+    );
+}
+
+sConfSubscriptions::Id sConfParser::subscribe(
+    const std::string& section,
+    sConfSubscriptions::Callback callback
+) {
+    return this->subscriptions.subscribe(
+        trimQuotes(trim(section)),
+        std::move(callback)
+    );
+}
+
+bool sConfParser::unsubscribe(sConfSubscriptions::Id id) {
+    return this->subscriptions.unsubscribe(id);
+}
+
+sConfMemoryUsage sConfParser::memoryUsage() const {
+    sConfMemoryUsage usage;
+    std::unordered_map<std::string, size_t> indices;
+    std::unordered_set<const std::string*> sources;
+
+    if(this->data) {
+        usage.tableBytes += this->data->bucket_count() * sizeof(void*);
+
+        for(const auto& [section, node] : *this->data) {
+            sConfMemoryUsage::SectionUsage entry;
+            entry.name = section;
+            entry.keyBytes = stringHeapBytes(section);
+            entry.tableBytes = hashNodeOverhead + sizeof(SectionTable::value_type) +
+                sizeof(SectionNode) + 2 * sizeof(void*);
+            entry.shared = node.use_count() > 1 || this->data.use_count() > 1;
+
+            // Sections not parsed yet are reported by the source bytes
+            // they will be parsed from; parsing them here would allocate
+            // the very memory being measured.
+            if(node->pending) {
+                if(sources.insert(node->pending->source.get()).second)
+                    usage.sourceBytes += node->pending->source->capacity() + 1;
+
+                if(!node->pending->materialized.load(std::memory_order_acquire)) {
+                    for(const auto& [begin, end] : node->pending->ranges)
+                        entry.pendingBytes += end - begin;
+
+                    usage.sections.push_back(std::move(entry));
+                    continue;
+                }
+            }
+
+            const Section& pairs = node->pairs;
+            entry.keys = pairs.size();
+            entry.tableBytes += pairs.bucket_count() * sizeof(void*) +
+                pairs.size() * hashNodeOverhead;
+            if(node->spans)
+                entry.tableBytes += sizeof(SpanTable) + 2 * sizeof(void*) +
+                    node->spans->entries.capacity() * sizeof(KeySpan);
+
+            for(const auto& [key, value] : pairs) {
+                entry.keyBytes += sizeof(std::string) + stringHeapBytes(key);
+                entry.valueBytes += sizeof(sConfValue) + value.stringHeapBytes();
+                entry.arrayBytes += value.arrayHeapBytes();
+            }
+
+            usage.sections.push_back(std::move(entry));
+        }
+    }
+
+    std::sort(
+        usage.sections.begin(),
+        usage.sections.end(),
+        [](const sConfMemoryUsage::SectionUsage& a, const sConfMemoryUsage::SectionUsage& b) {
+            return a.name < b.name;
+        }
+    );
+
+    for(size_t i = 0; i < usage.sections.size(); ++i)
+        indices[usage.sections[i].name] = i;
+
+    if(this->comments) {
+        usage.tableBytes += this->comments->bucket_count() * sizeof(void*);
+
+        for(const auto& [section, lines] : *this->comments) {
+            size_t bytes = hashNodeOverhead + sizeof(CommentTable::value_type) +
+                stringHeapBytes(section) + lines.capacity() * sizeof(std::string);
+
+            for(const auto& line : lines)
+                bytes += stringHeapBytes(line);
+
+            auto it = indices.find(section);
+            if(it != indices.end())
+                usage.sections[it->second].commentBytes += bytes;
+            else usage.commentBytes += bytes;
+        }
+    }
+
+    for(const auto& section : usage.sections) {
+        usage.keyBytes += section.keyBytes;
+        usage.valueBytes += section.valueBytes;
+        usage.arrayBytes += section.arrayBytes;
+        usage.tableBytes += section.tableBytes;
+        usage.commentBytes += section.commentBytes;
+        usage.pendingBytes += section.pendingBytes;
+    }
+
+    return usage;
+}
+
+sConfStats sConfParser::stats() const {
+    return this->statsRecorder.snapshot();
 }
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <charconv>
+#include <optional>
+#include <sconf_events.hpp>
+#include <sconf_exception.hpp>
+#include <sconf_schema.hpp>
+#include <sstream>
+
+#include "sconf_glob.hpp"
+#include "sconf_text.hpp"
+
+class sConfSchema::Validator : public sConfHandler {
+public:
+    explicit Validator(const sConfSchema& schema) :
+        schema(schema),
+        events(nullptr),
+        keys(nullptr),
+        seen(schema.rules.size()),
+        sectionLines(),
+        errors() {
+        this->onSection("");
+    }
+
+    void onSection(const std::string& name) override {
+        auto it = this->schema.index.find(name);
+        this->keys = it == this->schema.index.end() ? nullptr : &it->second;
+
+        if(this->keys && this->events)
+            this->sectionLines.emplace(name, this->events->getLineNumber());
+    }
+
+    void onKey(const std::string& key, const std::string& rawValue) override {
+        if(!this->keys)
+            return;
+
+        auto it = this->keys->find(key);
+        if(it == this->keys->end())
+            return;
+
+        this->seen[it->second] = 1;
+        this->schema.run(
+            this->schema.rules[it->second],
+            sConfValue::fromRaw(rawValue),
+            this->events->getLineNumber(),
+            this->errors
+        );
+    }
+
+    const sConfSchema& schema;
+    const sConfEventParser* events;
+    const std::unordered_map<std::string, std::size_t>* keys;
+    std::vector<char> seen;
+    std::unordered_map<std::string, std::size_t> sectionLines;
+    std::vector<sConfSchemaError> errors;
+};
+
+class sConfSchema::Reader : public sConfHandler {
+public:
+    explicit Reader(sConfSchema& schema) :
+        schema(schema),
+        events(nullptr),
+        section() {}
+
+    void onSection(const std::string& name) override {
+        this->section = name;
+    }
+
+    void onKey(const std::string& key, const std::string& rawValue) override;
+
+    sConfSchema& schema;
+    const sConfEventParser* events;
+    std::string section;
+};
+
+static std::optional<sConfValue::Type> parseType(const std::string& word, bool& valid) {
+    static const sConfValue::Type types[] = {
+        sConfValue::Type::String,
+        sConfValue::Type::Integer,
+        sConfValue::Type::Double,
+        sConfValue::Type::Boolean,
+        sConfValue::Type::Date,
+        sConfValue::Type::Array,
+        sConfValue::Type::Duration,
+        sConfValue::Type::Size
+    };
+
+    valid = true;
+    for(sConfValue::Type type : types)
+        if(word == sConfSchema::typeName(type))
+            return type;
+
+    valid = word == "any";
+    return std::nullopt;
+}
+
+template<typename T>
+static bool parseNumber(const std::string& text, T& number) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, number);
+
+    return !text.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+static bool hasType(const sConfValue& value, sConfValue::Type type) {
+    return value.getType() == type || value.getInferredType() == type;
+}
+
+static std::string formatNumber(double number) {
+    std::ostringstream out;
+    out << number;
+
+    return out.str();
+}
+
+void sConfSchema::addKey(const std::string& section, const std::string& key, const sConfKeyRule& rule) {
+    Rule compiled{section, key, rule.required, this->program.size(), 0};
+
+    if(rule.type)
+        this->program.push_back({Opcode::Type, *rule.type, 0, 0});
+    if(rule.elementType)
+        this->program.push_back({Opcode::ElementType, *rule.elementType, 0, 0});
+    if(rule.minLength)
+        this->program.push_back({Opcode::MinLength, sConfValue::Type::String, 0, *rule.minLength});
+    if(rule.maxLength)
+        this->program.push_back({Opcode::MaxLength, sConfValue::Type::String, 0, *rule.maxLength});
+    if(rule.min)
+        this->program.push_back({Opcode::Min, sConfValue::Type::Double, *rule.min, 0});
+    if(rule.max)
+        this->program.push_back({Opcode::Max, sConfValue::Type::Double, *rule.max, 0});
+
+    if(!rule.pattern.empty()) {
+        this->program.push_back({Opcode::Pattern, sConfValue::Type::String, 0, this->patterns.size()});
+        this->patterns.push_back(rule.pattern);
+    }
+
+    compiled.end = this->program.size();
+
+    auto [it, inserted] = this->index[section].emplace(key, this->rules.size());
+    if(inserted)
+        this->rules.push_back(std::move(compiled));
+    else this->rules[it->second] = std::move(compiled);
+}
+
+void sConfSchema::Reader::onKey(const std::string& key, const std::string& rawValue) {
+    sConfKeyRule rule;
+
+    try {
+        rule = sConfSchema::parseRule(sConfText::trimQuotes(rawValue));
+    }
+    catch(const SconfException& ex) {
+        throw SconfException(
+            std::string(ex.what()) + " (line " + std::to_string(this->events->getLineNumber()) + ")"
+        );
+    }
+
+    this->schema.addKey(this->section, key, rule);
+}
+
+void sConfSchema::load(const std::string& filename) {
+    sConfSchema extended = *this;
+    Reader reader(extended);
+    sConfEventParser events(reader);
+
+    reader.events = &events;
+    events.parseFile(filename);
+
+    *this = std::move(extended);
+}
+
+std::vector<sConfSchemaError> sConfSchema::validate(const sConfParser& document) const {
+    std::vector<sConfSchemaError> errors;
+    const sConfParser::Section* section = nullptr;
+    const std::string* current = nullptr;
+
+    for(const Rule& rule : this->rules) {
+        if(!current || *current != rule.section) {
+            current = &rule.section;
+            section = document.find(rule.section);
+        }
+
+        std::size_t reported = errors.size();
+        auto it = section ? section->find(rule.key) : sConfParser::Section::const_iterator();
+
+        if(section && it != section->end())
+            this->run(rule, it->second, 0, errors);
+        else if(rule.required)
+            errors.push_back({0, rule.section, rule.key, "Missing required key"});
+
+        if(errors.size() == reported)
+            continue;
+
+        std::optional<sConfLocation> location = section && it != section->end() ?
+            document.locate(rule.section, rule.key) :
+            document.locate(rule.section);
+        if(location)
+            for(std::size_t i = reported; i < errors.size(); ++i)
+                errors[i].line = location->line;
+    }
+
+    return errors;
+}
+
+std::vector<sConfSchemaError> sConfSchema::validateFile(const std::string& filename) const {
+    Validator validator(*this);
+    sConfEventParser events(validator);
+
+    validator.events = &events;
+    events.parseFile(filename);
+
+    this->reportMissing(validator.seen, validator.sectionLines, validator.errors);
+    return std::move(validator.errors);
+}
+
+const char* sConfSchema::typeName(sConfValue::Type type) {
+    switch(type) {
+        case sConfValue::Type::String:   return "string";
+        case sConfValue::Type::Integer:  return "integer";
+        case sConfValue::Type::Double:   return "double";
+        case sConfValue::Type::Boolean:  return "boolean";
+        case sConfValue::Type::Date:     return "date";
+        case sConfValue::Type::Array:    return "array";
+        case sConfValue::Type::Duration: return "duration";
+        case sConfValue::Type::Size:     return "size";
+    }
+
+    return "unknown";
+}
+
+void sConfSchema::run(
+    const Rule& rule,
+    const sConfValue& value,
+    std::size_t line,
+    std::vector<sConfSchemaError>& errors
+) const {
+    auto fail = [&](const std::string& message) {
+        errors.push_back({line, rule.section, rule.key, message});
+    };
+
+    for(std::size_t pc = rule.begin; pc < rule.end; ++pc) {
+        const Check& check = this->program[pc];
+
+        if(check.opcode == Opcode::Type) {
+            if(!hasType(value, check.type)) {
+                fail(std::string("Expected ") + typeName(check.type) + ", found " + typeName(value.getInferredType()));
+                return;
+            }
+
+            continue;
+        }
+
+        std::string message;
+        if(!value.isArray()) {
+            if(!this->runScalar(check, value, message))
+                fail(message);
+
+            continue;
+        }
+
+        std::size_t size = value.getArraySize();
+        switch(check.opcode) {
+            case Opcode::MinLength:
+                if(size < check.length)
+                    fail("Array has " + std::to_string(size) + " elements, fewer than " + std::to_string(check.length));
+                break;
+
+            case Opcode::MaxLength:
+                if(size > check.length)
+                    fail("Array has " + std::to_string(size) + " elements, more than " + std::to_string(check.length));
+                break;
+
+            case Opcode::ElementType:
+                for(std::size_t i = 0; i < size; ++i)
+                    if(!hasType(value.getElement(i), check.type)) {
+                        fail(
+                            "Element " + std::to_string(i) + ": expected " + typeName(check.type) +
+                            ", found " + typeName(value.getElement(i).getInferredType())
+                        );
+                        return;
+                    }
+                break;
+
+            default:
+                for(std::size_t i = 0; i < size; ++i)
+                    if(!this->runScalar(check, value.getElement(i), message)) {
+                        fail("Element " + std::to_string(i) + ": " + message);
+                        break;
+                    }
+                break;
+        }
+    }
+}
+
+bool sConfSchema::runScalar(const Check& check, const sConfValue& value, std::string& message) const {
+    sConfValue::Type type = value.getType();
+    sConfValue::Type inferred = value.getInferredType();
+    sConfResult<double> number = value.tryAs<double>();
+    bool numeric = inferred == sConfValue::Type::Integer || inferred == sConfValue::Type::Double;
+
+    switch(check.opcode) {
+        case Opcode::Min:
+        case Opcode::Max:
+            if(numeric && !number)
+                message = "Value " + value.toString() + " is out of range of 64-bit integers";
+            else if(numeric && check.opcode == Opcode::Min && *number < check.number)
+                message = "Value " + value.toString() + " is below the minimum of " + formatNumber(check.number);
+            else if(numeric && check.opcode == Opcode::Max && *number > check.number)
+                message = "Value " + value.toString() + " is above the maximum of " + formatNumber(check.number);
+            break;
+
+        case Opcode::MinLength:
+            if(type == sConfValue::Type::String && value.getString().size() < check.length)
+                message = "String is shorter than " + std::to_string(check.length) + " characters";
+            break;
+
+        case Opcode::MaxLength:
+            if(type == sConfValue::Type::String && value.getString().size() > check.length)
+                message = "String is longer than " + std::to_string(check.length) + " characters";
+            break;
+
+        case Opcode::Pattern:
+            if(type == sConfValue::Type::String &&
+                !sConfGlob::match(this->patterns[check.length], value.getString()))
+                message = "Value does not match the pattern " + this->patterns[check.length];
+            break;
+
+        default:
+            break;
+    }
+
+    return message.empty();
+}
+
+void sConfSchema::reportMissing(
+    const std::vector<char>& seen,
+    const std::unordered_map<std::string, std::size_t>& sectionLines,
+    std::vector<sConfSchemaError>& errors
+) const {
+    for(std::size_t i = 0; i < this->rules.size(); ++i) {
+        const Rule& rule = this->rules[i];
+        if(!rule.required || seen[i])
+            continue;
+
+        auto line = sectionLines.find(rule.section);
+        errors.push_back({
+            line == sectionLines.end() ? 0 : line->second,
+            rule.section,
+            rule.key,
+            "Missing required key"
+        });
+    }
+}
+
+sConfKeyRule sConfSchema::parseRule(const std::string& text) {
+    sConfKeyRule rule;
+    std::istringstream words(text);
+    std::string word;
+
+    while(words >> word) {
+        size_t equals = word.find('=');
+        std::string name = word.substr(0, equals),
+            argument = equals == std::string::npos ? "" : word.substr(equals + 1);
+        bool valid = true;
+
+        if(equals == std::string::npos) {
+            if(word == "required" || word == "optional")
+                rule.required = word == "required";
+            else rule.type = parseType(word, valid);
+        }
+        else if(name == "min" || name == "max") {
+            double number = 0;
+            valid = parseNumber(argument, number);
+
+            (name == "min" ? rule.min : rule.max) = number;
+        }
+        else if(name == "length") {
+            size_t dots = argument.find("..");
+            std::string lower = argument.substr(0, dots),
+                upper = dots == std::string::npos ? lower : argument.substr(dots + 2);
+            std::size_t bound = 0;
+
+            if(!lower.empty() && (valid = parseNumber(lower, bound)))
+                rule.minLength = bound;
+            if(valid && !upper.empty() && (valid = parseNumber(upper, bound)))
+                rule.maxLength = bound;
+            if(lower.empty() && upper.empty())
+                valid = false;
+        }
+        else if(name == "pattern" && !argument.empty())
+            rule.pattern = argument;
+        else if(name == "items") {
+            rule.elementType = parseType(argument, valid);
+            if(!rule.type)
+                rule.type = sConfValue::Type::Array;
+        }
+        else valid = false;
+
+        if(!valid)
+            throw SconfException("Invalid schema rule: " + word);
+    }
+
+    return rule;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf_stats.hpp>
+#include <sstream>
+
+double sConfStats::missRate(Accessor accessor) const {
+    if(this->lookups[accessor] == 0)
+        return 0.0;
+
+    return static_cast<double>(this->misses[accessor]) /
+        static_cast<double>(this->lookups[accessor]);
+}
+
+const char* sConfStats::phaseName(Phase phase) {
+    switch(phase) {
+        case Scan:     return "scan";
+        case Tokenize: return "tokenize";
+        case Decode:   return "decode";
+        case Insert:   return "insert";
+        default:       return "unknown";
+    }
+}
+
+const char* sConfStats::accessorName(Accessor accessor) {
+    switch(accessor) {
+        case GetSection:                return "getSection";
+        case HasSection:                return "hasSection";
+        case GetSectionKeyPair:         return "getSectionKeyPair";
+        case HasSectionPairByKey:       return "hasSectionPairByKey";
+        case IsSectionPairArray:        return "isSectionPairArray";
+        case IsSectionPairSingleString: return "isSectionPairSingleString";
+        case GetSectionComment:         return "getSectionComment";
+        case HasSectionComment:         return "hasSectionComment";
+        case Find:                      return "find";
+        case TryGet:                    return "tryGet";
+        default:                        return "unknown";
+    }
+}
+
+std::string sConfStats::toPrometheus(const std::string& prefix) const {
+    std::ostringstream out;
+    auto header = [&](const std::string& name, const char* type, const char* help) {
+        out << "# HELP " << prefix << "_" << name << " " << help << "\n"
+            << "# TYPE " << prefix << "_" << name << " " << type << "\n";
+    };
+
+    header("stats_enabled", "gauge", "Whether sConf instrumentation is compiled in.");
+    out << prefix << "_stats_enabled " << (this->enabled ? 1 : 0) << "\n";
+
+    header("parsed_bytes_total", "counter", "Bytes read while loading documents.");
+    out << prefix << "_parsed_bytes_total " << this->bytesParsed << "\n";
+
+    header("parsed_lines_total", "counter", "Lines read while loading documents.");
+    out << prefix << "_parsed_lines_total " << this->linesParsed << "\n";
+
+    header("parse_phase_seconds_total", "counter", "Time spent in each load phase.");
+    for(int phase = 0; phase < PhaseCount; ++phase)
+        out << prefix << "_parse_phase_seconds_total{phase=\"" << phaseName(static_cast<Phase>(phase))
+            << "\"} " << static_cast<double>(this->phaseNanoseconds[phase]) * 1e-9 << "\n";
+
+    header("parse_allocations_total", "counter", "Estimated heap allocations made while loading.");
+    out << prefix << "_parse_allocations_total " << this->allocations << "\n";
+
+    header("parse_allocated_bytes_total", "counter", "Estimated heap bytes allocated while loading.");
+    out << prefix << "_parse_allocated_bytes_total " << this->allocatedBytes << "\n";
+
+    header("lookups_total", "counter", "Calls to each lookup method.");
+    for(int accessor = 0; accessor < AccessorCount; ++accessor)
+        out << prefix << "_lookups_total{accessor=\"" << accessorName(static_cast<Accessor>(accessor))
+            << "\"} " << this->lookups[accessor] << "\n";
+
+    header("lookup_misses_total", "counter", "Calls to each lookup method that found nothing.");
+    for(int accessor = 0; accessor < AccessorCount; ++accessor)
+        out << prefix << "_lookup_misses_total{accessor=\"" << accessorName(static_cast<Accessor>(accessor))
+            << "\"} " << this->misses[accessor] << "\n";
+
+    header("saves_total", "counter", "Completed saves.");
+    out << prefix << "_saves_total " << this->saves << "\n";
+
+    header("save_seconds_total", "counter", "Time spent saving documents.");
+    out << prefix << "_save_seconds_total " << static_cast<double>(this->saveNanoseconds) * 1e-9 << "\n";
+
+    return out.str();
+}
+
+sConfStats sConfStatsRecorder::snapshot() const {
+    sConfStats stats;
+    if(!this->counters)
+        return stats;
+
+    const Counters& counters = *this->counters;
+
+    stats.enabled = true;
+    stats.bytesParsed = counters.bytesParsed.load(std::memory_order_relaxed);
+    stats.linesParsed = counters.linesParsed.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+    stats.saves = counters.saves.load(std::memory_order_relaxed);
+    stats.saveNanoseconds = counters.saveNanoseconds.load(std::memory_order_relaxed);
+
+    for(int phase = 0; phase < sConfStats::PhaseCount; ++phase)
+        stats.phaseNanoseconds[phase] = counters.phaseNanoseconds[phase].load(std::memory_order_relaxed);
+
+    for(int accessor = 0; accessor < sConfStats::AccessorCount; ++accessor) {
+        stats.lookups[accessor] = counters.lookups[accessor].load(std::memory_order_relaxed);
+        stats.misses[accessor] = counters.misses[accessor].load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+#ifdef SCONF_ENABLE_STATS
+static std::uint64_t elapsed(sConfStatsRecorder::TimePoint from, sConfStatsRecorder::TimePoint to) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count()
+    );
+}
+
+sConfStatsRecorder::sConfStatsRecorder() :
+    counters(std::make_unique<Counters>()) {}
+
+sConfStatsRecorder::TimePoint sConfStatsRecorder::now() {
+    return std::chrono::steady_clock::now();
+}
+
+sConfStatsRecorder::TimePoint sConfStatsRecorder::lap(sConfStats::Phase phase, TimePoint since) const {
+    TimePoint current = now();
+    if(this->counters)
+        this->counters->phaseNanoseconds[phase].fetch_add(elapsed(since, current), std::memory_order_relaxed);
+
+    return current;
+}
+
+void sConfStatsRecorder::line(std::size_t bytes) const {
+    if(!this->counters)
+        return;
+
+    this->counters->bytesParsed.fetch_add(bytes, std::memory_order_relaxed);
+    this->counters->linesParsed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void sConfStatsRecorder::allocation(std::size_t bytes) const {
+    if(!this->counters)
+        return;
+
+    this->counters->allocations.fetch_add(1, std::memory_order_relaxed);
+    this->counters->allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void sConfStatsRecorder::lookup(sConfStats::Accessor accessor, bool hit) const {
+    if(!this->counters)
+        return;
+
+    this->counters->lookups[accessor].fetch_add(1, std::memory_order_relaxed);
+    if(!hit)
+        this->counters->misses[accessor].fetch_add(1, std::memory_order_relaxed);
+}
+
+void sConfStatsRecorder::save(TimePoint since) const {
+    if(!this->counters)
+        return;
+
+    this->counters->saves.fetch_add(1, std::memory_order_relaxed);
+    this->counters->saveNanoseconds.fetch_add(elapsed(since, now()), std::memory_order_relaxed);
+}
+
+void sConfStatsRecorder::absorb(const sConfStatsRecorder& other) const {
+    if(!this->counters || !other.counters)
+        return;
+
+    Counters& mine = *this->counters;
+    const Counters& theirs = *other.counters;
+
+    mine.bytesParsed.fetch_add(theirs.bytesParsed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    mine.linesParsed.fetch_add(theirs.linesParsed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    mine.allocations.fetch_add(theirs.allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    mine.allocatedBytes.fetch_add(theirs.allocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    for(int phase = 0; phase < sConfStats::PhaseCount; ++phase)
+        mine.phaseNanoseconds[phase].fetch_add(
+            theirs.phaseNanoseconds[phase].load(std::memory_order_relaxed),
+            std::memory_order_relaxed
+        );
+}
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <map>
+#include <sconf_subscriptions.hpp>
+
+sConfSubscriptions::Id sConfSubscriptions::subscribe(
+    const std::string& section,
+    const std::string& key,
+    Callback callback
+) {
+    Id id = this->nextId++;
+
+    this->index[section].keys[key].push_back({id, std::move(callback)});
+    this->owners[id] = {section, key, false};
+
+    return id;
+}
+
+sConfSubscriptions::Id sConfSubscriptions::subscribe(
+    const std::string& section,
+    Callback callback
+) {
+    Id id = this->nextId++;
+
+    this->index[section].sectionWide.push_back({id, std::move(callback)});
+    this->owners[id] = {section, "", true};
+
+    return id;
+}
+
+bool sConfSubscriptions::unsubscribe(Id id) {
+    auto owner = this->owners.find(id);
+    if(owner == this->owners.end())
+        return false;
+
+    auto entry = this->index.find(owner->second.section);
+    if(entry != this->index.end()) {
+        auto byId = [id](const Subscriber& subscriber) {
+            return subscriber.id == id;
+        };
+
+        if(owner->second.sectionWide) {
+            auto& subscribers = entry->second.sectionWide;
+            subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), byId), subscribers.end());
+        }
+        else {
+            auto keyEntry = entry->second.keys.find(owner->second.key);
+            if(keyEntry != entry->second.keys.end()) {
+                auto& subscribers = keyEntry->second;
+                subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), byId), subscribers.end());
+
+                if(subscribers.empty())
+                    entry->second.keys.erase(keyEntry);
+            }
+        }
+
+        if(entry->second.sectionWide.empty() && entry->second.keys.empty())
+            this->index.erase(entry);
+    }
+
+    this->owners.erase(owner);
+    return true;
+}
+
+bool sConfSubscriptions::isWatched(const std::string& section) const {
+    return this->index.find(section) != this->index.end();
+}
+
+bool sConfSubscriptions::isEmpty() const {
+    return this->index.empty();
+}
+
+void sConfSubscriptions::dispatch(const std::vector<sConfChange>& changes) const {
+    if(this->index.empty() || changes.empty())
+        return;
+
+    std::map<Id, std::pair<Callback, std::vector<sConfChange>>> batches;
+    auto deliver = [&batches](const Subscriber& subscriber, const sConfChange& change) {
+        auto [it, inserted] = batches.try_emplace(subscriber.id);
+        if(inserted)
+            it->second.first = subscriber.callback;
+
+        it->second.second.push_back(change);
+    };
+
+    for(const auto& change : changes) {
+        auto entry = this->index.find(change.section);
+        if(entry == this->index.end())
+            continue;
+
+        for(const auto& subscriber : entry->second.sectionWide)
+            deliver(subscriber, change);
+
+        if(change.key.empty())
+            continue;
+
+        auto keyEntry = entry->second.keys.find(change.key);
+        if(keyEntry != entry->second.keys.end())
+            for(const auto& subscriber : keyEntry->second)
+                deliver(subscriber, change);
+    }
+
+    for(const auto& [_, batch] : batches)
+        batch.first(batch.second);
+}
+
+void sConfSubscriptions::dispatch(const sConfDiff& diff) const {
+    if(this->index.empty() || diff.isEmpty())
+        return;
+
+    std::vector<sConfChange> changes(
+        diff.getSectionChanges().begin(),
+        diff.getSectionChanges().end()
+    );
+
+    changes.insert(
+        changes.end(),
+        diff.getKeyChanges().begin(),
+        diff.getKeyChanges().end()
+    );
+
+    this->dispatch(changes);
+}
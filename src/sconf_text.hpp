@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_text.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Internal text helpers shared by the parsers.
+ */
+#ifndef SCONF_TEXT_HPP
+#define SCONF_TEXT_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+
+namespace sConfText {
+
+inline std::string trim(const std::string& str) {
+    auto start = std::find_if_not(str.begin(), str.end(), [](char c) { 
+        return std::isspace(c); 
+    });
+    auto end = std::find_if_not(str.rbegin(), str.rend(), [](char c) { 
+        return std::isspace(c); 
+    }).base();
+
+    return (start < end) ? std::string(start, end) : "";
+}
+
+inline std::string trimQuotes(const std::string& str) {
+    if(str.size() >= 2 && str.front() == '"' && str.back() == '"')
+        return str.substr(1, str.size() - 2);
+    return str;
+}
+
+inline std::string_view normalize(std::string_view str) {
+    std::size_t start = 0, end = str.size();
+    while(start < end && std::isspace(static_cast<unsigned char>(str[start])))
+        ++start;
+    while(end > start && std::isspace(static_cast<unsigned char>(str[end - 1])))
+        --end;
+
+    str = str.substr(start, end - start);
+    if(str.size() >= 2 && str.front() == '"' && str.back() == '"')
+        str = str.substr(1, str.size() - 2);
+    return str;
+}
+
+inline bool isArray(const std::string& value) {
+    return !value.empty() && value.front() == '[' && value.back() == ']';
+}
+
+}
+
+#endif
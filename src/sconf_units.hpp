@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_units.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Internal helpers reading and writing durations such as `1h30m`
+ *        and byte sizes such as `64MiB`.
+ */
+#ifndef SCONF_UNITS_HPP
+#define SCONF_UNITS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace sConfUnits {
+
+struct Unit {
+    const char* name;
+    std::uint64_t factor;
+};
+
+inline const Unit durationUnits[] = {
+    {"d", 86400000000000ull},
+    {"h", 3600000000000ull},
+    {"m", 60000000000ull},
+    {"s", 1000000000ull},
+    {"ms", 1000000ull},
+    {"us", 1000ull},
+    {"ns", 1ull}
+};
+
+inline const Unit sizeUnits[] = {
+    {"PiB", 1ull << 50},
+    {"PB", 1000000000000000ull},
+    {"TiB", 1ull << 40},
+    {"TB", 1000000000000ull},
+    {"GiB", 1ull << 30},
+    {"GB", 1000000000ull},
+    {"MiB", 1ull << 20},
+    {"MB", 1000000ull},
+    {"KiB", 1ull << 10},
+    {"kB", 1000ull},
+    {"KB", 1000ull},
+    {"B", 1ull}
+};
+
+template<std::size_t N>
+inline const Unit* findUnit(const Unit (&units)[N], std::string_view text, std::size_t begin, std::size_t end) {
+    for(const Unit& unit : units)
+        if(text.compare(begin, end - begin, unit.name) == 0)
+            return &unit;
+
+    return nullptr;
+}
+
+inline bool isDigit(char c) {
+    return static_cast<unsigned char>(c - '0') <= 9;
+}
+
+inline bool isLetter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+template<std::size_t N>
+inline bool readQuantity(
+    const Unit (&units)[N],
+    std::string_view text,
+    std::size_t& pos,
+    std::uint64_t& result
+) {
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t whole = 0, fraction = 0, scale = 1;
+
+    if(pos == text.size() || !isDigit(text[pos]))
+        return false;
+
+    for(; pos < text.size() && isDigit(text[pos]); ++pos) {
+        std::uint64_t digit = static_cast<std::uint64_t>(text[pos] - '0');
+        if(whole > (max - digit) / 10)
+            return false;
+
+        whole = whole * 10 + digit;
+    }
+
+    if(pos < text.size() && text[pos] == '.') {
+        if(++pos == text.size() || !isDigit(text[pos]))
+            return false;
+
+        for(; pos < text.size() && isDigit(text[pos]); ++pos)
+            if(scale < 1000000000ull) {
+                fraction = fraction * 10 + static_cast<std::uint64_t>(text[pos] - '0');
+                scale *= 10;
+            }
+    }
+
+    std::size_t unitStart = pos;
+    while(pos < text.size() && isLetter(text[pos]))
+        ++pos;
+
+    const Unit* unit = findUnit(units, text, unitStart, pos);
+    if(!unit || whole > max / unit->factor)
+        return false;
+
+    std::uint64_t part = unit->factor / scale * fraction +
+        unit->factor % scale * fraction / scale;
+    if(whole * unit->factor > max - part)
+        return false;
+
+    result = whole * unit->factor + part;
+    return true;
+}
+
+inline bool parseDuration(std::string_view text, std::int64_t& nanoseconds) {
+    if(text.empty() || !isLetter(text.back()))
+        return false;
+
+    bool negative = text[0] == '-';
+    std::size_t pos = negative ? 1 : 0;
+    std::uint64_t total = 0, limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+
+    do {
+        std::uint64_t part = 0;
+        if(!readQuantity(durationUnits, text, pos, part) || part > limit - total)
+            return false;
+
+        total += part;
+    } while(pos < text.size());
+
+    nanoseconds = negative ?
+        -static_cast<std::int64_t>(total) :
+        static_cast<std::int64_t>(total);
+    return true;
+}
+
+inline bool parseSize(std::string_view text, std::uint64_t& bytes) {
+    if(text.empty() || text.back() != 'B')
+        return false;
+
+    std::size_t pos = 0;
+    return readQuantity(sizeUnits, text, pos, bytes) && pos == text.size();
+}
+
+inline std::string formatDuration(std::int64_t nanoseconds) {
+    if(nanoseconds == 0)
+        return "0s";
+
+    std::string text = nanoseconds < 0 ? "-" : "";
+    std::uint64_t rest = nanoseconds < 0 ?
+        0 - static_cast<std::uint64_t>(nanoseconds) :
+        static_cast<std::uint64_t>(nanoseconds);
+
+    for(const Unit& unit : durationUnits)
+        if(rest >= unit.factor) {
+            text += std::to_string(rest / unit.factor) + unit.name;
+            rest %= unit.factor;
+        }
+
+    return text;
+}
+
+inline std::string formatSize(std::uint64_t bytes) {
+    for(const Unit& unit : sizeUnits)
+        if(bytes != 0 && bytes % unit.factor == 0)
+            return std::to_string(bytes / unit.factor) + unit.name;
+
+    return "0B";
+}
+
+}
+
+#endif
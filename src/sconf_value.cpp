@@ -16,136 +16,681 @@
  * along with N8. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <regex>
+#include <cctype>
+#include <charconv>
 #include <sconf_exception.hpp>
 #include <sconf_value.hpp>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+
+#include "sconf_date.hpp"
+#include "sconf_text.hpp"
+#include "sconf_units.hpp"
+
+sConfValue::sConfValue(const sConfValue& other) :
+    sConfValue() {
+    this->assign(other, false);
+}
+
+sConfValue::sConfValue(const std::tm& val) :
+    sConfValue(TimePoint(std::chrono::seconds(sConfDate::fromTm(val)))) {}
+
+sConfValue::sConfValue(TimePoint val) :
+    stringValue(sConfDate::format(val.time_since_epoch().count())),
+    values({}),
+    type(Type::Date),
+    scalar(),
+    state(State::Decoded) {
+    this->scalar.date = val.time_since_epoch().count();
+}
+
+sConfValue::sConfValue(std::chrono::nanoseconds val) :
+    stringValue(sConfUnits::formatDuration(val.count())),
+    values({}),
+    type(Type::Duration),
+    scalar(),
+    state(State::Decoded) {
+    this->scalar.duration = val.count();
+}
+
+sConfValue sConfValue::fromSize(std::uint64_t bytes) {
+    sConfValue value(sConfUnits::formatSize(bytes));
+
+    value.type = Type::Size;
+    value.scalar.size = bytes;
+    return value;
+}
+
+sConfValue::sConfValue(sConfValue&& other) noexcept :
+    sConfValue() {
+    this->assign(other, true);
+}
+
+sConfValue& sConfValue::operator=(const sConfValue& other) {
+    if(this != &other)
+        this->assign(other, false);
+    return *this;
+}
+
+sConfValue& sConfValue::operator=(sConfValue&& other) noexcept {
+    if(this != &other)
+        this->assign(other, true);
+    return *this;
+}
+
+void sConfValue::assign(const sConfValue& other, bool move) {
+    auto take = [move](auto& field) {
+        return move ? std::move(field) : field;
+    };
+
+    if(other.acquireRaw()) {
+        this->stringValue = take(other.stringValue);
+        this->values.clear();
+        this->type = Type::String;
+        this->untyped = other.untyped;
+        this->state.store(State::Raw, std::memory_order_relaxed);
+
+        other.releaseRaw();
+        return;
+    }
+
+    this->stringValue = take(other.stringValue);
+    this->values = take(other.values);
+    this->type = other.type;
+    this->untyped = other.untyped;
+    this->aboveInt64 = other.aboveInt64;
+    this->overflow = other.overflow;
+    this->scalar = other.scalar;
+    this->state.store(State::Decoded, std::memory_order_relaxed);
+}
+
+sConfValue sConfValue::fromRaw(const std::string& text) {
+    sConfValue value(text);
+
+    value.state.store(State::Raw, std::memory_order_relaxed);
+    return value;
+}
+
+sConfValue sConfValue::fromText(const std::string& text) {
+    sConfValue value = fromRaw(text);
+
+    value.untyped = true;
+    return value;
+}
+
+bool sConfValue::acquireRaw() const {
+    while(true) {
+        State current = this->state.load(std::memory_order_acquire);
+        if(current == State::Decoded)
+            return false;
+
+        if(current == State::Raw &&
+            this->state.compare_exchange_weak(current, State::Decoding, std::memory_order_acquire))
+            return true;
+
+        std::this_thread::yield();
+    }
+}
+
+void sConfValue::releaseRaw() const {
+    this->state.store(State::Raw, std::memory_order_release);
+}
+
+void sConfValue::decode() const {
+    if(!this->acquireRaw())
+        return;
+
+    try {
+        this->infer();
+    }
+    catch(...) {
+        this->releaseRaw();
+        throw;
+    }
+
+    this->state.store(State::Decoded, std::memory_order_release);
+}
+
+void sConfValue::infer() const {
+    std::string_view text = this->stringValue;
+
+    if(text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+        this->type = Type::String;
+        this->stringValue.pop_back();
+        this->stringValue.erase(0, 1);
+    }
+    else if(text.size() >= 2 && text.front() == '[' && text.back() == ']') {
+        std::string_view items = text.substr(1, text.size() - 2);
+        std::vector<sConfValue> elements;
+
+        for(std::size_t start = 0; start < items.size();) {
+            std::size_t comma = std::min(items.find(',', start), items.size());
+            std::string item = sConfText::trim(std::string(items.substr(start, comma - start)));
+
+            sConfValue element = this->untyped ? fromText(item) : fromRaw(item);
+            element.decode();
+
+            elements.push_back(std::move(element));
+            start = comma + 1;
+        }
+
+        this->values = std::move(elements);
+        this->stringValue.clear();
+        this->type = Type::Array;
+    }
+    else if(text == "true" || text == "false") {
+        this->type = Type::Boolean;
+        this->scalar.boolean = text == "true";
+    }
+    else if(parseInteger(text, this->scalar, this->aboveInt64, this->overflow))
+        this->type = Type::Integer;
+    else if(isNumber(text) &&
+        std::from_chars(text.data(), text.data() + text.size(), this->scalar.real).ec == std::errc())
+        this->type = Type::Double;
+    else if(parseDate(text, this->scalar.date))
+        this->type = Type::Date;
+    else if(sConfUnits::parseDuration(text, this->scalar.duration))
+        this->type = Type::Duration;
+    else if(sConfUnits::parseSize(text, this->scalar.size))
+        this->type = Type::Size;
+    else this->type = Type::String;
+}
+
+sConfValue::Type sConfValue::decodedType(bool inferred) const noexcept {
+    try {
+        return inferred ? this->getInferredType() : this->getType();
+    }
+    catch(...) {
+        return Type::Array;
+    }
+}
 
 sConfValue::Type sConfValue::getType() const {
+    this->decode();
+    return this->untyped && this->type != Type::Array ? Type::String : this->type;
+}
+
+sConfValue::Type sConfValue::getInferredType() const {
+    this->decode();
     return this->type;
 }
 
 bool sConfValue::isArray() const {
-    return this->type == Type::Array;
+    return this->getType() == Type::Array;
 }
 
 int sConfValue::getInteger() const {
-    if(this->type != Type::Integer)
+    if(this->getInferredType() != Type::Integer)
         throw SconfException("Value is not an integer");
 
-    return std::stoi(this->stringValue);
+    if(this->overflow || this->aboveInt64 ||
+        this->scalar.integer < std::numeric_limits<int>::min() ||
+        this->scalar.integer > std::numeric_limits<int>::max())
+        throw SconfException("Integer is out of range of int");
+
+    return static_cast<int>(this->scalar.integer);
+}
+
+std::int64_t sConfValue::getInteger64() const {
+    if(this->getInferredType() != Type::Integer)
+        throw SconfException("Value is not an integer");
+
+    if(this->overflow || this->aboveInt64)
+        throw SconfException("Integer is out of range of int64");
+
+    return this->scalar.integer;
+}
+
+std::uint64_t sConfValue::getUnsigned() const {
+    if(this->getInferredType() != Type::Integer)
+        throw SconfException("Value is not an integer");
+
+    if(this->overflow)
+        throw SconfException("Integer is out of range of uint64");
+
+    if(this->aboveInt64)
+        return this->scalar.unsignedInteger;
+
+    if(this->scalar.integer < 0)
+        throw SconfException("Integer is negative");
+
+    return static_cast<std::uint64_t>(this->scalar.integer);
 }
 
 double sConfValue::getDouble() const {
-    if(this->type != Type::Double)
+    Type current = this->getInferredType();
+    if(current == Type::Integer && this->overflow)
+        throw SconfException("Integer is out of range of 64 bits");
+
+    if(current == Type::Integer)
+        return this->aboveInt64 ?
+            static_cast<double>(this->scalar.unsignedInteger) :
+            static_cast<double>(this->scalar.integer);
+
+    if(current != Type::Double)
         throw SconfException("Value is not a double");
 
-    return std::stod(this->stringValue);
+    return this->scalar.real;
 }
 
 bool sConfValue::getBoolean() const {
-    if(this->type != Type::Boolean)
+    if(this->getInferredType() != Type::Boolean)
         throw SconfException("Value is not a boolean");
 
-    return this->stringValue == "true";
+    return this->scalar.boolean;
 }
 
 std::string sConfValue::getString() const {
-    if(this->type != Type::String)
+    if(this->getType() != Type::String)
         throw SconfException("Value is not a string");
 
     return this->stringValue;
 }
 
+std::string sConfValue::toString() const {
+    if(this->getType() != Type::Array)
+        return this->stringValue;
+
+    std::string text = "[";
+    for(size_t i = 0; i < this->values.size(); ++i) {
+        if(i > 0)
+            text += ", ";
+        text += this->values[i].toString();
+    }
+
+    return text + "]";
+}
+
 std::tm sConfValue::getDate() const {
-    if(this->type != Type::Date)
+    if(this->getInferredType() != Type::Date)
+        throw SconfException("Value is not a date");
+
+    return sConfDate::toTm(this->scalar.date);
+}
+
+sConfValue::TimePoint sConfValue::getTimePoint() const {
+    if(this->getInferredType() != Type::Date)
         throw SconfException("Value is not a date");
 
-    return parseDate(this->stringValue);
+    return TimePoint(std::chrono::seconds(this->scalar.date));
+}
+
+std::chrono::nanoseconds sConfValue::getDuration() const {
+    if(this->getInferredType() != Type::Duration)
+        throw SconfException("Value is not a duration");
+
+    return std::chrono::nanoseconds(this->scalar.duration);
+}
+
+std::uint64_t sConfValue::getSize() const {
+    Type current = this->getInferredType();
+    if(current == Type::Integer && this->overflow)
+        throw SconfException("Integer is out of range of 64 bits");
+
+    if(current == Type::Integer && (this->aboveInt64 || this->scalar.integer >= 0))
+        return this->aboveInt64 ?
+            this->scalar.unsignedInteger :
+            static_cast<std::uint64_t>(this->scalar.integer);
+
+    if(current != Type::Size)
+        throw SconfException("Value is not a size");
+
+    return this->scalar.size;
 }
 
 std::vector<sConfValue> sConfValue::getArray() const {
-    if(this->type != Type::Array)
+    if(this->getType() != Type::Array)
         throw SconfException("Value is not an array");
 
     return this->values;
 }
 
+std::size_t sConfValue::getArraySize() const {
+    if(this->getType() != Type::Array)
+        throw SconfException("Value is not an array");
+
+    return this->values.size();
+}
+
+const sConfValue& sConfValue::getElement(std::size_t index) const {
+    if(this->getType() != Type::Array)
+        throw SconfException("Value is not an array");
+
+    if(index >= this->values.size())
+        throw SconfException("Array index out of range: " + std::to_string(index));
+
+    return this->values[index];
+}
+
+template<>
+sConfResult<int> sConfValue::tryAs<int>() const noexcept {
+    if(this->decodedType(true) != Type::Integer)
+        return sConfError::TypeMismatch;
+
+    if(this->overflow || this->aboveInt64 ||
+        this->scalar.integer < std::numeric_limits<int>::min() ||
+        this->scalar.integer > std::numeric_limits<int>::max())
+        return sConfError::OutOfRange;
+
+    return static_cast<int>(this->scalar.integer);
+}
+
+template<>
+sConfResult<std::int64_t> sConfValue::tryAs<std::int64_t>() const noexcept {
+    if(this->decodedType(true) != Type::Integer)
+        return sConfError::TypeMismatch;
+
+    if(this->overflow || this->aboveInt64)
+        return sConfError::OutOfRange;
+
+    return this->scalar.integer;
+}
+
+template<>
+sConfResult<double> sConfValue::tryAs<double>() const noexcept {
+    Type current = this->decodedType(true);
+    if(current == Type::Integer && this->overflow)
+        return sConfError::OutOfRange;
+
+    if(current == Type::Integer)
+        return this->aboveInt64 ?
+            static_cast<double>(this->scalar.unsignedInteger) :
+            static_cast<double>(this->scalar.integer);
+
+    if(current != Type::Double)
+        return sConfError::TypeMismatch;
+
+    return this->scalar.real;
+}
+
+template<>
+sConfResult<bool> sConfValue::tryAs<bool>() const noexcept {
+    if(this->decodedType(true) != Type::Boolean)
+        return sConfError::TypeMismatch;
+
+    return this->scalar.boolean;
+}
+
+template<>
+sConfResult<std::string> sConfValue::tryAs<std::string>() const {
+    if(this->getType() != Type::String)
+        return sConfError::TypeMismatch;
+
+    return this->stringValue;
+}
+
+template<>
+sConfResult<std::string_view> sConfValue::tryAs<std::string_view>() const noexcept {
+    if(this->decodedType(false) != Type::String)
+        return sConfError::TypeMismatch;
+
+    return std::string_view(this->stringValue);
+}
+
+template<>
+sConfResult<std::tm> sConfValue::tryAs<std::tm>() const noexcept {
+    if(this->decodedType(true) != Type::Date)
+        return sConfError::TypeMismatch;
+
+    return sConfDate::toTm(this->scalar.date);
+}
+
+template<>
+sConfResult<sConfValue::TimePoint> sConfValue::tryAs<sConfValue::TimePoint>() const noexcept {
+    if(this->decodedType(true) != Type::Date)
+        return sConfError::TypeMismatch;
+
+    return TimePoint(std::chrono::seconds(this->scalar.date));
+}
+
+template<>
+sConfResult<std::chrono::nanoseconds> sConfValue::tryAs<std::chrono::nanoseconds>() const noexcept {
+    if(this->decodedType(true) != Type::Duration)
+        return sConfError::TypeMismatch;
+
+    return std::chrono::nanoseconds(this->scalar.duration);
+}
+
+template<>
+sConfResult<std::uint64_t> sConfValue::tryAs<std::uint64_t>() const noexcept {
+    Type current = this->decodedType(true);
+    if(current == Type::Integer)
+        return !this->overflow && (this->aboveInt64 || this->scalar.integer >= 0) ?
+            sConfResult<std::uint64_t>(this->aboveInt64 ?
+                this->scalar.unsignedInteger :
+                static_cast<std::uint64_t>(this->scalar.integer)) :
+            sConfResult<std::uint64_t>(sConfError::OutOfRange);
+
+    if(current != Type::Size)
+        return sConfError::TypeMismatch;
+
+    return this->scalar.size;
+}
+
+template<>
+sConfResult<std::vector<sConfValue>> sConfValue::tryAs<std::vector<sConfValue>>() const {
+    if(this->getType() != Type::Array)
+        return sConfError::TypeMismatch;
+
+    return this->values;
+}
+
+template<>
+sConfResult<sConfValue> sConfValue::tryAs<sConfValue>() const {
+    return *this;
+}
+
 void sConfValue::setInteger(int value) {
-    this->type = Type::Integer;
-    this->stringValue = std::to_string(value);
+    *this = sConfValue(value);
+}
 
-    this->values.clear();
+void sConfValue::setInteger64(std::int64_t value) {
+    *this = sConfValue(value);
 }
 
-void sConfValue::setDouble(double value) {
-    this->type = Type::Double;
-    this->stringValue = std::to_string(value);
+void sConfValue::setUnsigned(std::uint64_t value) {
+    *this = sConfValue(value);
+}
 
-    this->values.clear();
+void sConfValue::setDouble(double value) {
+    *this = sConfValue(value);
 }
 
 void sConfValue::setBoolean(bool value) {
-    this->type = Type::Boolean;
-    this->stringValue = value ? "true" : "false";
-
-    this->values.clear();
+    *this = sConfValue(value);
 }
 
 void sConfValue::setString(const std::string& value) {
-    this->type = Type::String;
-    this->stringValue = value;
-
-    this->values.clear();
+    *this = sConfValue(value);
 }
 
 void sConfValue::setDate(const std::tm& value) {
-    this->type = Type::Date;
+    *this = sConfValue(value);
+}
 
-    char buffer[32];
-    std::strftime(
-        buffer,
-        sizeof(buffer),
-        "%Y-%m-%d %H:%M:%S",
-        &value
-    );
+void sConfValue::setTimePoint(TimePoint value) {
+    *this = sConfValue(value);
+}
+
+void sConfValue::setDuration(std::chrono::nanoseconds value) {
+    *this = sConfValue(value);
+}
 
-    this->stringValue = buffer;
-    this->values.clear();
+void sConfValue::setSize(std::uint64_t value) {
+    *this = fromSize(value);
 }
 
 void sConfValue::setArray(const std::vector<sConfValue>& value) {
-    this->type = Type::Array;
-    this->values = value;
+    *this = sConfValue(value);
+}
+
+bool sConfValue::operator==(const sConfValue& other) const {
+    Type current = this->getType();
+    if(current != other.getType())
+        return false;
+
+    switch(current) {
+        case Type::Array:
+            return this->values == other.values;
+
+        case Type::Integer:
+            if(this->overflow || other.overflow)
+                return this->overflow == other.overflow && this->stringValue == other.stringValue;
+
+            return this->aboveInt64 == other.aboveInt64 && (this->aboveInt64 ?
+                this->scalar.unsignedInteger == other.scalar.unsignedInteger :
+                this->scalar.integer == other.scalar.integer);
+
+        case Type::Double:
+            return this->scalar.real == other.scalar.real;
+
+        case Type::Boolean:
+            return this->scalar.boolean == other.scalar.boolean;
+
+        case Type::Date:
+            return this->scalar.date == other.scalar.date;
+
+        case Type::Duration:
+            return this->scalar.duration == other.scalar.duration;
+
+        case Type::Size:
+            return this->scalar.size == other.scalar.size;
 
-    this->stringValue.clear();
+        default:
+            return this->stringValue == other.stringValue;
+    }
+}
+
+bool sConfValue::operator!=(const sConfValue& other) const {
+    return !(*this == other);
+}
+
+std::size_t sConfValue::stringHeapBytes() const {
+    static const std::size_t inlineCapacity = std::string().capacity();
+    bool raw = this->acquireRaw();
+
+    std::size_t capacity = this->stringValue.capacity();
+    if(raw)
+        this->releaseRaw();
+
+    return capacity <= inlineCapacity ? 0 : capacity + 1;
 }
 
-bool sConfValue::isNumber(const std::string& str) {
-    return std::regex_match(str, std::regex("^-?\\d+(\\.\\d+)?$"));
+std::size_t sConfValue::arrayHeapBytes() const {
+    if(this->acquireRaw()) {
+        this->releaseRaw();
+        return 0;
+    }
+
+    std::size_t bytes = this->values.capacity() * sizeof(sConfValue);
+    for(const auto& element : this->values)
+        bytes += element.stringHeapBytes() + element.arrayHeapBytes();
+
+    return bytes;
 }
 
-bool sConfValue::isIntegral(const std::string& str) {
-    return std::regex_match(str, std::regex("^-?\\d+$"));
+static bool isDigits(std::string_view str, size_t& pos) {
+    size_t start = pos;
+    while(pos < str.size() && std::isdigit(static_cast<unsigned char>(str[pos])))
+        ++pos;
+
+    return pos > start;
 }
 
-std::tm sConfValue::parseDate(const std::string& str) {
-    std::tm tm{};
-    std::istringstream ss(str);
-    
-    if(str.length() > 10)
-        ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-    else {
-        ss >> std::get_time(&tm, "%Y-%m-%d");
+bool sConfValue::isNumber(std::string_view str) {
+    size_t pos = (!str.empty() && str[0] == '-') ? 1 : 0;
+    if(!isDigits(str, pos))
+        return false;
+
+    if(pos < str.size() && str[pos] == '.' && !isDigits(str, ++pos))
+        return false;
 
-        tm.tm_hour = 0;
-        tm.tm_min = 0;
-        tm.tm_sec = 0;
+    if(pos < str.size() && (str[pos] == 'e' || str[pos] == 'E')) {
+        ++pos;
+        if(pos < str.size() && (str[pos] == '+' || str[pos] == '-'))
+            ++pos;
+
+        if(!isDigits(str, pos))
+            return false;
+    }
+
+    return pos == str.size();
+}
+
+static int digitValue(char c) {
+    if(c >= '0' && c <= '9')
+        return c - '0';
+
+    c = static_cast<char>(c | 0x20);
+    return c >= 'a' && c <= 'z' ? c - 'a' + 10 : 36;
+}
+
+bool sConfValue::parseInteger(std::string_view str, Scalar& scalar, bool& aboveInt64, bool& overflow) {
+    const char* it = str.data();
+    const char* end = it + str.size();
+
+    bool negative = it != end && *it == '-';
+    it += negative;
+
+    int base = 10;
+    if(end - it > 2 && it[0] == '0') {
+        char prefix = static_cast<char>(it[1] | 0x20);
+        base = prefix == 'x' ? 16 : prefix == 'o' ? 8 : prefix == 'b' ? 2 : 10;
+        it += base == 10 ? 0 : 2;
+    }
+
+    char digits[64];
+    std::size_t count = 0;
+    bool tooLong = false;
+
+    if(it == end || *it == '_')
+        return false;
+
+    for(; it != end; ++it) {
+        if(*it == '_') {
+            if(it + 1 == end || it[1] == '_')
+                return false;
+            continue;
+        }
+
+        if(digitValue(*it) >= base)
+            return false;
+
+        if(count == 0 && *it == '0')
+            continue;
+
+        if(count == sizeof(digits))
+            tooLong = true;
+        else digits[count++] = *it;
+    }
+
+    std::uint64_t magnitude = 0;
+    if(!tooLong && count > 0) {
+        auto [last, error] = std::from_chars(digits, digits + count, magnitude, base);
+        tooLong = error == std::errc::result_out_of_range;
+
+        if(!tooLong && (error != std::errc() || last != digits + count))
+            return false;
     }
 
-    if(ss.fail())
-        throw SconfException("Invalid date format. Expected yyyy-MM-dd [hh:mm:ss]");
+    const std::uint64_t int64Max = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+    overflow = tooLong || (negative && magnitude > int64Max + 1);
+    aboveInt64 = false;
+
+    if(overflow)
+        return true;
+
+    aboveInt64 = !negative && magnitude > int64Max;
+    if(aboveInt64)
+        scalar.unsignedInteger = magnitude;
+    else scalar.integer = negative ?
+        static_cast<std::int64_t>(0 - magnitude) :
+        static_cast<std::int64_t>(magnitude);
+
+    return true;
+}
 
-    return tm;
+bool sConfValue::parseDate(std::string_view str, std::int64_t& seconds) {
+    return sConfDate::parse(str, seconds);
 }
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <sconf_exception.hpp>
+#include <sconf_watcher.hpp>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+static std::string watchedDirectory(const std::string& filename) {
+    std::string directory = std::filesystem::path(filename).parent_path().string();
+    return directory.empty() ? "." : directory;
+}
+
+sConfWatcher::~sConfWatcher() {
+    this->stop();
+}
+
+void sConfWatcher::start() {
+#ifdef __linux__
+    if(this->worker.joinable()) {
+        if(this->running.load())
+            throw SconfException("Watcher is already running");
+
+        // The previous thread left its loop on its own; reap it so the
+        // watcher can be started again.
+        this->worker.join();
+        close(this->wakeFd);
+        this->wakeFd = -1;
+    }
+
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(inotifyFd < 0)
+        throw SconfException("Failed to initialize inotify: " + std::string(std::strerror(errno)));
+
+    this->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(this->wakeFd < 0) {
+        close(inotifyFd);
+        throw SconfException("Failed to create wake descriptor: " + std::string(std::strerror(errno)));
+    }
+
+    this->directories.clear();
+    for(const auto& filename : this->filenames) {
+        std::string directory = watchedDirectory(filename);
+        int descriptor = inotify_add_watch(
+            inotifyFd,
+            directory.c_str(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE
+        );
+
+        if(descriptor < 0) {
+            close(inotifyFd);
+            close(this->wakeFd);
+            this->wakeFd = -1;
+
+            throw SconfException("Failed to watch directory: " + directory);
+        }
+
+        this->directories[descriptor] = directory;
+    }
+
+    this->running.store(true);
+    this->worker = std::thread(&sConfWatcher::run, this, inotifyFd);
+#else
+    throw SconfException("File watching is only supported on Linux");
+#endif
+}
+
+void sConfWatcher::stop() {
+#ifdef __linux__
+    if(!this->worker.joinable())
+        return;
+
+    this->running.store(false);
+
+    std::uint64_t one = 1;
+    ssize_t written = write(this->wakeFd, &one, sizeof(one));
+    (void) written;
+
+    this->worker.join();
+    close(this->wakeFd);
+    this->wakeFd = -1;
+
+    std::lock_guard<std::mutex> lock(this->callbackMutex);
+    this->pending.clear();
+#endif
+}
+
+bool sConfWatcher::isRunning() const noexcept {
+    return this->running.load();
+}
+
+void sConfWatcher::onReload(ReloadCallback callback) {
+    std::lock_guard<std::mutex> lock(this->callbackMutex);
+    this->reloadCallbacks.push_back(std::move(callback));
+}
+
+void sConfWatcher::onError(ErrorCallback callback) {
+    std::lock_guard<std::mutex> lock(this->callbackMutex);
+    this->errorCallbacks.push_back(std::move(callback));
+}
+
+std::future<sConfConcurrent::Snapshot> sConfWatcher::nextReload() {
+    std::lock_guard<std::mutex> lock(this->callbackMutex);
+
+    this->pending.emplace_back();
+    return this->pending.back().get_future();
+}
+
+bool sConfWatcher::isWatched(
+    const std::string& directory,
+    const std::string& name
+) const {
+    for(const auto& filename : this->filenames)
+        if(watchedDirectory(filename) == directory &&
+            std::filesystem::path(filename).filename() == name)
+            return true;
+
+    return false;
+}
+
+void sConfWatcher::reload() {
+    sConfConcurrent::Snapshot snapshot;
+    std::string error;
+
+    try {
+        sConfParser parser;
+        for(const auto& filename : this->filenames)
+            parser.load(filename);
+
+        snapshot = std::make_shared<const sConfParser>(std::move(parser));
+        this->target.publish(snapshot);
+    }
+    catch(const std::exception& ex) {
+        snapshot.reset();
+        error = ex.what();
+    }
+
+    std::vector<std::promise<sConfConcurrent::Snapshot>> promises;
+    std::vector<ReloadCallback> onReloadCallbacks;
+    std::vector<ErrorCallback> onErrorCallbacks;
+
+    {
+        std::lock_guard<std::mutex> lock(this->callbackMutex);
+        promises.swap(this->pending);
+
+        if(snapshot)
+            onReloadCallbacks = this->reloadCallbacks;
+        else onErrorCallbacks = this->errorCallbacks;
+    }
+
+    // Every promise is settled exactly once before any user code runs,
+    // so a throwing callback can neither leave a future hanging nor
+    // make a promise be satisfied twice.
+    for(auto& promise : promises)
+        if(snapshot)
+            promise.set_value(snapshot);
+        else promise.set_exception(std::make_exception_ptr(SconfException(error)));
+
+    for(const auto& callback : onReloadCallbacks)
+        try {
+            callback(snapshot);
+        }
+        catch(...) {}
+
+    for(const auto& callback : onErrorCallbacks)
+        try {
+            callback(error);
+        }
+        catch(...) {}
+}
+
+void sConfWatcher::run(int inotifyFd) {
+#ifdef __linux__
+    this->reload();
+
+    alignas(struct inotify_event) char buffer[4096];
+    pollfd descriptors[2] = {
+        {inotifyFd, POLLIN, 0},
+        {this->wakeFd, POLLIN, 0}
+    };
+
+    bool dirty = false;
+    std::chrono::steady_clock::time_point deadline;
+
+    while(this->running.load()) {
+        int timeout = -1;
+        if(dirty) {
+            // A steady stream of events would otherwise push the reload
+            // back forever, so the quiet period is cut short at the
+            // deadline set by the first change.
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()
+            );
+
+            if(left.count() <= 0) {
+                dirty = false;
+                this->reload();
+
+                continue;
+            }
+
+            timeout = static_cast<int>(std::min(this->debounce, left).count());
+        }
+
+        int ready = poll(descriptors, 2, timeout);
+
+        if(ready < 0) {
+            if(errno == EINTR)
+                continue;
+            break;
+        }
+
+        if(descriptors[1].revents & POLLIN)
+            break;
+
+        if(ready == 0) {
+            dirty = false;
+            this->reload();
+
+            continue;
+        }
+
+        ssize_t length;
+        while((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+            for(char* cursor = buffer; cursor < buffer + length;) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(cursor);
+                cursor += sizeof(struct inotify_event) + event->len;
+
+                auto directory = this->directories.find(event->wd);
+                if(event->len > 0 && directory != this->directories.end() &&
+                    this->isWatched(directory->second, event->name) && !dirty) {
+                    dirty = true;
+                    deadline = std::chrono::steady_clock::now() + this->maxDelay;
+                }
+            }
+    }
+
+    close(inotifyFd);
+    this->running.store(false);
+#else
+    (void) inotifyFd;
+#endif
+}
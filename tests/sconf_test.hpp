@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sconf_test.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Minimal test harness shared by the sConf test executables.
+ *
+ * Each test file defines its cases with SCONF_TEST and runs them from
+ * main() with sConfTest::run(). A failed check is reported with its file
+ * and line and fails the case without stopping the others, and the
+ * process exits with a non-zero status if any case failed, as ctest
+ * expects.
+ */
+#ifndef SCONF_TEST_HPP
+#define SCONF_TEST_HPP
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace sConfTest {
+
+/**
+ * @brief A registered test case.
+ */
+struct Case {
+    const char* name;
+    std::function<void()> body;
+};
+
+/**
+ * @brief Retrieves the cases registered in this executable.
+ * @return The cases, in definition order.
+ */
+inline std::vector<Case>& cases() {
+    static std::vector<Case> registered;
+    return registered;
+}
+
+/**
+ * @brief Retrieves the number of failed checks of the running case.
+ * @return The failure counter.
+ */
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+/**
+ * @brief Registers a case at static initialization time.
+ */
+struct Registrar {
+    Registrar(const char* name, std::function<void()> body) {
+        cases().push_back({name, std::move(body)});
+    }
+};
+
+/**
+ * @brief Records the outcome of a check.
+ * @param passed Whether the check held.
+ * @param expression The checked expression, as written.
+ * @param file The source file of the check.
+ * @param line The source line of the check.
+ */
+inline void check(bool passed, const char* expression, const char* file, int line) {
+    if(passed)
+        return;
+
+    ++failures();
+    std::cerr << "  " << file << ":" << line << ": check failed: " << expression << '\n';
+}
+
+/**
+ * @brief Runs every registered case.
+ * @return The process exit status: 0 if every case passed, 1 otherwise.
+ */
+inline int run() {
+    int failed = 0;
+
+    for(const auto& testCase : cases()) {
+        failures() = 0;
+
+        try {
+            testCase.body();
+        }
+        catch(const std::exception& ex) {
+            ++failures();
+            std::cerr << "  unexpected exception: " << ex.what() << '\n';
+        }
+
+        std::cout << (failures() ? "FAIL " : "ok   ") << testCase.name << '\n';
+        if(failures())
+            ++failed;
+    }
+
+    std::cout << cases().size() - failed << "/" << cases().size() << " passed\n";
+    return failed ? 1 : 0;
+}
+
+/**
+ * @class TempDir
+ * @brief A fresh directory for the files of one case, removed afterwards.
+ */
+class TempDir {
+public:
+    TempDir() {
+        static std::atomic<unsigned> counter{0};
+
+        this->root = std::filesystem::temp_directory_path() /
+            ("sconf_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_" + std::to_string(counter++));
+        std::filesystem::remove_all(this->root);
+        std::filesystem::create_directories(this->root);
+    }
+
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    ~TempDir() {
+        std::error_code error;
+        std::filesystem::remove_all(this->root, error);
+    }
+
+    /**
+     * @brief Builds the path of a file in the directory.
+     * @param name The file name.
+     * @return The full path.
+     */
+    std::string path(const std::string& name) const {
+        return (this->root / name).string();
+    }
+
+    /**
+     * @brief Writes a file, replacing any previous content.
+     * @param name The file name.
+     * @param content The file content.
+     * @return The full path.
+     */
+    std::string write(const std::string& name, const std::string& content) const {
+        std::string filename = this->path(name);
+        std::ofstream(filename, std::ios::binary | std::ios::trunc) << content;
+
+        return filename;
+    }
+
+private:
+    std::filesystem::path root;
+};
+
+}
+
+#define SCONF_TEST_CONCAT_(a, b) a##b
+#define SCONF_TEST_CONCAT(a, b) SCONF_TEST_CONCAT_(a, b)
+
+/**
+ * @brief Defines and registers a test case.
+ */
+#define SCONF_TEST(name)                                                    \
+    static void name();                                                     \
+    static sConfTest::Registrar SCONF_TEST_CONCAT(name, Registrar)(#name, name); \
+    static void name()
+
+/**
+ * @brief Checks that a condition holds.
+ */
+#define SCONF_CHECK(condition) \
+    sConfTest::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+/**
+ * @brief Checks that an expression throws an exception of the given type.
+ */
+#define SCONF_CHECK_THROWS(expression, exception)                  \
+    do {                                                           \
+        bool thrown = false;                                       \
+        try { (void) (expression); }                               \
+        catch(const exception&) { thrown = true; }                 \
+        sConfTest::check(thrown, #expression " throws " #exception, __FILE__, __LINE__); \
+    } while(false)
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <sconf.hpp>
+#include <string>
+#include <vector>
+#include "sconf_test.hpp"
+
+struct Server {
+    std::string host = "localhost";
+    int port = 8080;
+    bool secure = false;
+    double ratio = 0.5;
+    std::vector<int> ports;
+    std::chrono::nanoseconds timeout = std::chrono::seconds(5);
+    std::string version;
+};
+
+SCONF_BIND(Server, "server", host, port, secure, ratio, ports, timeout, version)
+
+SCONF_TEST(missingKeysKeepDefaults) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[server]\nhost = example.org\nunbound = 1\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    Server server = sConfBinder<Server>::load(parser);
+    SCONF_CHECK(server.host == "example.org");
+    SCONF_CHECK(server.port == 8080);
+    SCONF_CHECK(!server.secure);
+    SCONF_CHECK(server.timeout == std::chrono::seconds(5));
+
+    sConfParser empty;
+    Server untouched;
+    untouched.port = 1;
+    sConfLoad(empty, untouched);
+    SCONF_CHECK(untouched.port == 1 && untouched.host == "localhost");
+}
+
+SCONF_TEST(loadsEveryFieldType) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nport = 9090\nsecure = true\nratio = 0.25\nports = [80, 443]\ntimeout = 250ms\nversion = 1.2\n");
+
+    sConfLoadOptions typed;
+    typed.inferTypes = true;
+
+    for(const sConfLoadOptions& options : {sConfLoadOptions(), typed}) {
+        sConfParser parser;
+        parser.load(file, options);
+
+        Server server = sConfBinder<Server>::load(parser);
+        SCONF_CHECK(server.port == 9090);
+        SCONF_CHECK(server.secure);
+        SCONF_CHECK(server.ratio == 0.25);
+        SCONF_CHECK(server.ports == std::vector<int>({80, 443}));
+        SCONF_CHECK(server.timeout == std::chrono::milliseconds(250));
+        SCONF_CHECK(server.version == "1.2");
+    }
+}
+
+SCONF_TEST(typeMismatchReportsLocation) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[server]\nhost = example.org\nport = eighty\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    std::string message;
+    try {
+        sConfBinder<Server>::load(parser);
+    }
+    catch(const SconfException& ex) {
+        message = ex.what();
+    }
+
+    SCONF_CHECK(message.find(file + ":3:") == 0);
+    SCONF_CHECK(message.find("server.port") != std::string::npos);
+}
+
+SCONF_TEST(roundTripsThroughSave) {
+    sConfTest::TempDir dir;
+
+    Server original;
+    original.host = "example.org";
+    original.port = 9443;
+    original.secure = true;
+    original.ratio = 0.75;
+    original.ports = {80, 443, 8443};
+    original.timeout = std::chrono::minutes(2);
+    original.version = "2.0";
+
+    sConfParser parser;
+    sConfSave(parser, original);
+    parser.save(dir.path("saved.sconf"));
+
+    sConfParser reloaded;
+    reloaded.load(dir.path("saved.sconf"));
+
+    Server copy = sConfBinder<Server>::load(reloaded);
+    SCONF_CHECK(copy.host == original.host);
+    SCONF_CHECK(copy.port == original.port);
+    SCONF_CHECK(copy.secure == original.secure);
+    SCONF_CHECK(copy.ratio == original.ratio);
+    SCONF_CHECK(copy.ports == original.ports);
+    SCONF_CHECK(copy.timeout == original.timeout);
+    SCONF_CHECK(copy.version == original.version);
+}
+
+struct Raw {
+    sConfValue value;
+    int port = 0;
+};
+
+SCONF_BIND(Raw, "raw", value, port)
+
+SCONF_TEST(copyingReadersMayThrow) {
+    sConfValue value;
+    sConfValue field;
+    int port = 0;
+
+    static_assert(!noexcept(sConfFieldTraits<sConfValue>::read(value, field)), "copying a value may throw");
+    static_assert(noexcept(sConfFieldTraits<int>::read(value, port)), "reading an int must not throw");
+
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[raw]\nvalue = [1, 2, 3]\nport = 80\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    Raw raw = sConfBinder<Raw>::load(parser);
+    SCONF_CHECK(raw.value.isArray() && raw.value.getArraySize() == 3);
+    SCONF_CHECK(raw.port == 80);
+}
+
+int main() {
+    return sConfTest::run();
+}
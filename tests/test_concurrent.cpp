@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <sconf.hpp>
+#include <thread>
+#include <vector>
+#include "sconf_test.hpp"
+
+static sConfParser version(int number) {
+    sConfParser parser;
+    parser.addSection("app");
+    parser.setKey("app", "version", sConfValue(number));
+    parser.setKey("app", "twice", sConfValue(number * 2));
+
+    return parser;
+}
+
+static bool consistent(const sConfParser& parser, int& number) {
+    sConfResult<int> value = parser.tryGet<int>("app", "version");
+    sConfResult<int> twice = parser.tryGet<int>("app", "twice");
+    if(!value || !twice || *twice != *value * 2)
+        return false;
+
+    number = *value;
+    return true;
+}
+
+SCONF_TEST(readersSeeWholeVersionsWhilePublishing) {
+    const int publications = 2000;
+    sConfConcurrent document(version(0));
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+
+    for(int thread = 0; thread < 4; ++thread)
+        readers.emplace_back([&, thread]() {
+            sConfConcurrent::Reader reader(document);
+            int last = 0;
+
+            while(!done.load(std::memory_order_acquire)) {
+                int number = 0;
+                bool whole = thread % 2 == 0 ?
+                    consistent(*document.snapshot(), number) :
+                    consistent(*reader, number);
+
+                if(!whole || number < last)
+                    failures.fetch_add(1, std::memory_order_relaxed);
+
+                last = number;
+            }
+        });
+
+    std::thread writer([&]() {
+        for(int number = 1; number <= publications; ++number) {
+            if(number % 2 == 0)
+                document.publish(version(number));
+            else
+                document.update([number](sConfParser& parser) {
+                    parser.setKey("app", "version", sConfValue(number));
+                    parser.setKey("app", "twice", sConfValue(number * 2));
+                });
+        }
+    });
+
+    writer.join();
+    done.store(true, std::memory_order_release);
+    for(std::thread& reader : readers)
+        reader.join();
+
+    int number = 0;
+    SCONF_CHECK(failures.load() == 0);
+    SCONF_CHECK(document.version() == static_cast<std::uint64_t>(publications));
+    SCONF_CHECK(consistent(*document.snapshot(), number) && number == publications);
+}
+
+SCONF_TEST(snapshotsOutliveLaterPublications) {
+    sConfConcurrent document(version(1));
+    sConfConcurrent::Snapshot held = document.snapshot();
+
+    document.publish(version(2));
+
+    int number = 0;
+    SCONF_CHECK(consistent(*held, number) && number == 1);
+    SCONF_CHECK(consistent(*document.snapshot(), number) && number == 2);
+    SCONF_CHECK_THROWS(document.publish(sConfConcurrent::Snapshot()), SconfException);
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+static sConfParser loadSample(sConfTest::TempDir& dir) {
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\nport = 8080\n[client]\nretries = 3\n[cache]\nsize = 64\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    return parser;
+}
+
+SCONF_TEST(copiesShareUntouchedSections) {
+    sConfTest::TempDir dir;
+    sConfParser original = loadSample(dir);
+    const sConfParser copy(original);
+
+    SCONF_CHECK(copy.find("server") == original.find("server"));
+    SCONF_CHECK(copy.find("client") == original.find("client"));
+    SCONF_CHECK(copy.find("server", "host") == original.find("server", "host"));
+}
+
+SCONF_TEST(setKeyOnCopyLeavesOriginalUntouched) {
+    sConfTest::TempDir dir;
+    const sConfParser original = loadSample(dir);
+    sConfParser copy(original);
+
+    copy.setKey("server", "port", sConfValue(9090));
+    copy.setKey("server", "tls", sConfValue(true));
+
+    SCONF_CHECK(copy.getOr("server", "port", 0) == 9090);
+    SCONF_CHECK(original.getOr("server", "port", 0) == 8080);
+    SCONF_CHECK(original.find("server", "tls") == nullptr);
+
+    SCONF_CHECK(copy.find("server") != original.find("server"));
+    SCONF_CHECK(copy.find("client") == original.find("client"));
+    SCONF_CHECK(copy.find("cache") == original.find("cache"));
+}
+
+SCONF_TEST(removeSectionOnCopyLeavesOriginalUntouched) {
+    sConfTest::TempDir dir;
+    const sConfParser original = loadSample(dir);
+    sConfParser copy(original);
+
+    copy.removeSection("client");
+    copy.removeSectionPairByKey("server", "host");
+
+    SCONF_CHECK(!copy.hasSection("client"));
+    SCONF_CHECK(original.hasSection("client"));
+    SCONF_CHECK(original.getOr("client", "retries", 0) == 3);
+    SCONF_CHECK(copy.find("server", "host") == nullptr);
+    SCONF_CHECK(original.getOr("server", "host", "") == "example.org");
+    SCONF_CHECK(copy.find("cache") == original.find("cache"));
+}
+
+SCONF_TEST(writesToOriginalLeaveCopyUntouched) {
+    sConfTest::TempDir dir;
+    sConfParser original = loadSample(dir);
+    const sConfParser copy(original);
+
+    original.setKey("client", "retries", sConfValue(5));
+    original.removeSection("cache");
+
+    SCONF_CHECK(copy.getOr("client", "retries", 0) == 3);
+    SCONF_CHECK(copy.getOr("cache", "size", 0) == 64);
+    SCONF_CHECK(copy.find("server") == original.find("server"));
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <ctime>
+#include <sconf.hpp>
+#include <string>
+#include "sconf_test.hpp"
+
+SCONF_TEST(formatRoundTripsParsedDates) {
+    for(const char* text : {
+        "2024-02-29 12:34:56",
+        "2000-02-29 00:00:00",
+        "1969-12-31 23:59:59",
+        "1970-01-01 00:00:00",
+        "0001-01-01 00:00:00",
+        "9999-12-31 23:59:59"
+    }) {
+        sConfValue value = sConfValue::fromRaw(text);
+
+        SCONF_CHECK(value.getType() == sConfValue::Type::Date);
+        SCONF_CHECK(value.toString() == text);
+        SCONF_CHECK(sConfValue(value.getDate()).toString() == text);
+        SCONF_CHECK(sConfValue(value.getTimePoint()).toString() == text);
+    }
+
+    SCONF_CHECK(sConfValue(sConfValue::fromRaw("2024-03-01").getDate()).toString() == "2024-03-01 00:00:00");
+}
+
+SCONF_TEST(datesConvertToCalendarFields) {
+    std::tm date = sConfValue::fromRaw("2024-02-29 08:15:30").getDate();
+
+    SCONF_CHECK(date.tm_year == 124 && date.tm_mon == 1 && date.tm_mday == 29);
+    SCONF_CHECK(date.tm_hour == 8 && date.tm_min == 15 && date.tm_sec == 30);
+    SCONF_CHECK(date.tm_wday == 4 && date.tm_yday == 59);
+
+    SCONF_CHECK(sConfValue::fromRaw("1970-01-02").getTimePoint() ==
+        sConfValue::TimePoint(std::chrono::hours(24)));
+    SCONF_CHECK(sConfValue::fromRaw("1969-12-31 23:59:59").getTimePoint() ==
+        sConfValue::TimePoint(std::chrono::seconds(-1)));
+}
+
+SCONF_TEST(rejectsImpossibleDates) {
+    for(const char* text : {
+        "2024-02-30",
+        "2024-13-01",
+        "2024-00-10",
+        "2024-04-31",
+        "2023-02-29",
+        "1900-02-29",
+        "2024-01-00",
+        "2024-01-01 24:00:00",
+        "2024-01-01 23:60:00",
+        "2024-01-01 23:59:60",
+        "2024-1-01",
+        "2024-01-01T00:00:00"
+    }) {
+        SCONF_CHECK(sConfValue::fromRaw(text).getType() == sConfValue::Type::String);
+        SCONF_CHECK(!sConfValue::fromText(text).tryAs<std::tm>());
+        SCONF_CHECK_THROWS(sConfValue::fromText(text).getDate(), SconfException);
+    }
+}
+
+SCONF_TEST(loadedDatesSaveInCanonicalForm) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[release]\nday = 2024-02-29\nbad = 2023-02-29\n");
+
+    sConfLoadOptions options;
+    options.inferTypes = true;
+
+    sConfParser parser;
+    parser.load(file, options);
+    parser.save(dir.path("saved.sconf"));
+
+    sConfParser saved;
+    saved.load(dir.path("saved.sconf"));
+
+    SCONF_CHECK(saved.getOr("release", "day", "") == "2024-02-29 00:00:00");
+    SCONF_CHECK(saved.getOr("release", "bad", "") == "2023-02-29");
+    SCONF_CHECK(saved.find("release", "day")->getDate().tm_mday == 29);
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include <sstream>
+#include "sconf_test.hpp"
+
+/**
+ * @brief Handler recording every event as one line of text.
+ */
+struct Recorder : sConfHandler {
+    std::vector<std::string> events;
+
+    void onSection(const std::string& name) override {
+        this->events.push_back("section " + name);
+    }
+
+    void onComment(const std::string& text) override {
+        this->events.push_back("comment " + text);
+    }
+
+    void onInclude(const std::string& path) override {
+        this->events.push_back("include " + path);
+    }
+
+    void onKey(const std::string& key, const std::string& rawValue) override {
+        this->events.push_back("key " + key + " " + rawValue);
+    }
+
+    void onValue(const std::string& text) override {
+        this->events.push_back("value " + text);
+    }
+
+    void onArrayBegin() override {
+        this->events.push_back("[");
+    }
+
+    void onArrayEnd() override {
+        this->events.push_back("]");
+    }
+
+    bool onError(const sConfDiagnostic& diagnostic) override {
+        this->events.push_back("error " + std::to_string(diagnostic.line));
+        return true;
+    }
+};
+
+static const std::string document =
+    "; header\n"
+    "[server]\n"
+    "host = \"example.org\" ; trailing\n"
+    "ports = [80, 443]\n"
+    "@include \"extra.sconf\"\n"
+    "broken line\n"
+    "last = 1";
+
+static std::vector<std::string> parsed(const std::string& input) {
+    Recorder recorder;
+    std::istringstream stream(input);
+    sConfEventParser(recorder).parse(stream);
+
+    return recorder.events;
+}
+
+SCONF_TEST(parseReportsEveryEvent) {
+    std::vector<std::string> expected = {
+        "comment header",
+        "section server",
+        "key host \"example.org\"",
+        "value example.org",
+        "key ports [80, 443]",
+        "[", "value 80", "value 443", "]",
+        "include extra.sconf",
+        "error 6",
+        "key last 1",
+        "value 1"
+    };
+
+    SCONF_CHECK(parsed(document) == expected);
+}
+
+SCONF_TEST(feedMatchesParseForEverySplit) {
+    std::vector<std::string> expected = parsed(document);
+
+    for(std::size_t split = 0; split <= document.size(); ++split) {
+        Recorder recorder;
+        sConfEventParser events(recorder);
+
+        events.feed(document.data(), split);
+        events.feed(document.data() + split, document.size() - split);
+        events.finish();
+
+        SCONF_CHECK(recorder.events == expected);
+    }
+}
+
+SCONF_TEST(feedAcceptsSingleBytes) {
+    Recorder recorder;
+    sConfEventParser events(recorder);
+
+    for(char byte : document)
+        events.feed(&byte, 1);
+    events.finish();
+
+    SCONF_CHECK(recorder.events == parsed(document));
+    SCONF_CHECK(events.getLineNumber() == 7);
+}
+
+SCONF_TEST(defaultHandlerThrowsOnMalformedLine) {
+    sConfHandler handler;
+    sConfEventParser events(handler);
+
+    SCONF_CHECK_THROWS(events.parseLine("not a pair"), SconfException);
+}
+
+SCONF_TEST(streamLoadsChunkedInput) {
+    std::string input = "[server]\nhost = example.org\nport = 8080\n[client]\nretries = 3";
+
+    sConfParser parser;
+    sConfParser::Stream stream(parser, "chunked.sconf");
+    for(std::size_t offset = 0; offset < input.size(); offset += 5)
+        stream.feed(input.data() + offset, std::min<std::size_t>(5, input.size() - offset));
+
+    SCONF_CHECK(!parser.hasSection("server"));
+    stream.finish();
+
+    SCONF_CHECK(parser.getOr("server", "host", "") == "example.org");
+    SCONF_CHECK(parser.getOr("server", "port", 0) == 8080);
+    SCONF_CHECK(parser.getOr("client", "retries", 0) == 3);
+
+    std::optional<sConfLocation> location = parser.locate("client", "retries");
+    SCONF_CHECK(location && location->line == 5);
+    SCONF_CHECK_THROWS(stream.finish(), SconfException);
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+SCONF_TEST(includingFileOverridesIncludedFile) {
+    sConfTest::TempDir dir;
+    dir.write("defaults.sconf", "[server]\nhost = localhost\nport = 80\n");
+    std::string file = dir.write("app.sconf",
+        "[server]\nport = 8080\n@include \"defaults.sconf\"\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    parser.load(file);
+
+    SCONF_CHECK(parser.getOr("server", "host", "") == "localhost");
+    SCONF_CHECK(parser.getOr("server", "port", 0) == 8080);
+}
+
+SCONF_TEST(laterIncludesOverrideEarlierOnes) {
+    sConfTest::TempDir dir;
+    dir.write("first.sconf", "[server]\nport = 1\nhost = first\n");
+    dir.write("second.sconf", "[server]\nport = 2\n");
+    std::string file = dir.write("app.sconf",
+        "@include \"first.sconf\"\n@include \"second.sconf\"\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    parser.load(file);
+
+    SCONF_CHECK(parser.getOr("server", "port", 0) == 2);
+    SCONF_CHECK(parser.getOr("server", "host", "") == "first");
+}
+
+SCONF_TEST(nestedIncludesResolveRelativeToIncludingFile) {
+    sConfTest::TempDir dir;
+    std::filesystem::create_directories(dir.path("common"));
+    dir.write("common/base.sconf", "[db]\nname = base\n");
+    dir.write("common/shared.sconf", "@include \"base.sconf\"\n[db]\nuser = shared\n");
+    std::string file = dir.write("app.sconf", "@include \"common/shared.sconf\"\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    parser.load(file);
+
+    SCONF_CHECK(parser.getOr("db", "name", "") == "base");
+    SCONF_CHECK(parser.getOr("db", "user", "") == "shared");
+}
+
+SCONF_TEST(includeCycleIsRejected) {
+    sConfTest::TempDir dir;
+    dir.write("a.sconf", "@include \"b.sconf\"\n[a]\nkey = 1\n");
+    dir.write("b.sconf", "@include \"a.sconf\"\n[b]\nkey = 2\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    SCONF_CHECK_THROWS(parser.load(dir.path("a.sconf")), SconfException);
+    SCONF_CHECK(!parser.hasSection("a"));
+}
+
+SCONF_TEST(failedIncludeLeavesDocumentUntouched) {
+    sConfTest::TempDir dir;
+    dir.write("i1.sconf", "[one]\nkey = 1\n");
+    dir.write("i2.sconf", "[two\nkey = 2\n");
+    std::string file = dir.write("app.sconf",
+        "@include \"i1.sconf\"\n@include \"i2.sconf\"\n[app]\nkey = 3\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    parser.addSection("kept");
+
+    SCONF_CHECK_THROWS(parser.load(file), SconfException);
+    SCONF_CHECK(parser.hasSection("kept"));
+    SCONF_CHECK(!parser.hasSection("one"));
+    SCONF_CHECK(!parser.hasSection("app"));
+}
+
+SCONF_TEST(manyIncludesShareTheirCommonFiles) {
+    sConfTest::TempDir dir;
+    dir.write("common.sconf", "[common]\nkey = 1\n");
+
+    std::string body;
+    for(int i = 0; i < 200; ++i) {
+        std::string name = "part" + std::to_string(i) + ".sconf";
+        dir.write(name, "@include \"common.sconf\"\n[part" + std::to_string(i) + "]\nkey = " + std::to_string(i) + "\n");
+        body += "@include \"" + name + "\"\n";
+    }
+    std::string file = dir.write("app.sconf", body);
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    parser.load(file);
+
+    SCONF_CHECK(parser.getOr("common", "key", 0) == 1);
+    SCONF_CHECK(parser.getOr("part0", "key", -1) == 0);
+    SCONF_CHECK(parser.getOr("part199", "key", 0) == 199);
+}
+
+SCONF_TEST(selfIncludeIsRejected) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("self.sconf", "@include \"self.sconf\"\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    SCONF_CHECK_THROWS(parser.load(file), SconfException);
+}
+
+SCONF_TEST(cacheClearsAfterRejectedCycle) {
+    std::string body;
+    for(int i = 0; i < 200000; ++i)
+        body += "key" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+
+    sConfTest::TempDir dir;
+    dir.write("a.sconf", "@include \"b.sconf\"\n@include \"c.sconf\"\n[a]\nkey = 1\n");
+    dir.write("b.sconf", "@include \"a.sconf\"\n");
+    dir.write("c.sconf", "[c]\n" + body + "@include \"d.sconf\"\n");
+    dir.write("d.sconf", "[d]\nkey = 4\n");
+    std::string self = dir.write("self.sconf", "[self]\n" + body + "@include \"self.sconf\"\n");
+
+    sConfParser::clearIncludeCache();
+    SCONF_CHECK_THROWS(sConfParser().load(dir.path("a.sconf")), SconfException);
+    sConfParser::clearIncludeCache();
+
+    SCONF_CHECK_THROWS(sConfParser().load(self), SconfException);
+    sConfParser::clearIncludeCache();
+}
+
+SCONF_TEST(selfIncludeIsReportedAtItsLine) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("self.sconf", "[a]\nkey = 1\n@include \"self.sconf\"\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    std::vector<sConfDiagnostic> errors = parser.tryLoad(file);
+
+    SCONF_CHECK(errors.size() == 1);
+    SCONF_CHECK(errors[0].kind == sConfDiagnostic::Kind::IncludeFailed);
+    SCONF_CHECK(errors[0].line == 3);
+    SCONF_CHECK(parser.getOr("a", "key", 0) == 1);
+}
+
+SCONF_TEST(missingIncludeIsReported) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "@include \"missing.sconf\"\n");
+
+    sConfParser::clearIncludeCache();
+    sConfParser parser;
+    SCONF_CHECK_THROWS(parser.load(file), std::exception);
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+SCONF_TEST(referencesExpandInDependencyOrder) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[paths]\nurl = ${paths.base}/api\nbase = https://${net.host}\n"
+        "[net]\nhost = example.org\n");
+
+    sConfParser parser;
+    parser.load(file);
+    parser.interpolate();
+
+    SCONF_CHECK(parser.getOr("paths", "base", "") == "https://example.org");
+    SCONF_CHECK(parser.getOr("paths", "url", "") == "https://example.org/api");
+}
+
+SCONF_TEST(singleReferenceKeepsType) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nport = 8080\n[client]\nport = ${server.port}\nlabel = port ${server.port}\n");
+
+    sConfLoadOptions options;
+    options.inferTypes = true;
+
+    sConfParser parser;
+    parser.load(file, options);
+    parser.interpolate();
+
+    const sConfValue* port = parser.find("client", "port");
+    SCONF_CHECK(port && port->getType() == sConfValue::Type::Integer);
+    SCONF_CHECK(parser.getOr("client", "port", 0) == 8080);
+    SCONF_CHECK(parser.getOr("client", "label", "") == "port 8080");
+}
+
+SCONF_TEST(environmentReferencesAndEscapes) {
+    setenv("SCONF_TEST_HOME", "/srv/app", 1);
+
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[paths]\nhome = ${ENV:SCONF_TEST_HOME}/data\nliteral = $${paths.home}\n");
+
+    sConfParser parser;
+    parser.load(file);
+    parser.interpolate();
+
+    SCONF_CHECK(parser.getOr("paths", "home", "") == "/srv/app/data");
+    SCONF_CHECK(parser.getOr("paths", "literal", "") == "${paths.home}");
+}
+
+SCONF_TEST(escapesSurviveLaterInterpolation) {
+    sConfTest::TempDir dir;
+    std::string first = dir.write("first.sconf", "[paths]\nbase = /srv\nlit = \"$${X}\"\nurl = ${paths.base}/api\n");
+    std::string second = dir.write("second.sconf", "[other]\nkey = 1\n");
+
+    sConfLoadOptions options;
+    options.interpolate = true;
+
+    sConfParser parser;
+    parser.load(first, options);
+    SCONF_CHECK(parser.getOr("paths", "lit", "") == "${X}");
+
+    parser.load(second, options);
+    parser.interpolate();
+    SCONF_CHECK(parser.getOr("paths", "lit", "") == "${X}");
+    SCONF_CHECK(parser.getOr("paths", "url", "") == "/srv/api");
+    SCONF_CHECK(parser.getOr("other", "key", 0) == 1);
+
+    parser.reload(first);
+    SCONF_CHECK(parser.getOr("paths", "lit", "") == "${X}");
+    SCONF_CHECK(parser.getOr("paths", "url", "") == "/srv/api");
+}
+
+SCONF_TEST(setKeyReexpandsDependents) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[net]\nhost = example.org\n[paths]\nurl = https://${net.host}/\n");
+
+    sConfParser parser;
+    parser.load(file);
+    parser.interpolate();
+    parser.setKey("net", "host", sConfValue(std::string("example.net")));
+
+    SCONF_CHECK(parser.getOr("paths", "url", "") == "https://example.net/");
+}
+
+SCONF_TEST(cycleAndMissingReferencesAreRejected) {
+    sConfTest::TempDir dir;
+    std::string cyclic = dir.write("cycle.sconf", "[a]\nx = ${a.y}\ny = ${a.x}\n");
+    std::string missing = dir.write("missing.sconf", "[a]\nx = ${a.nothing}\n");
+
+    sConfParser cycle;
+    cycle.load(cyclic);
+    SCONF_CHECK_THROWS(cycle.interpolate(), SconfException);
+    SCONF_CHECK(cycle.getOr("a", "x", "") == "${a.y}");
+
+    sConfParser absent;
+    absent.load(missing);
+    SCONF_CHECK_THROWS(absent.interpolate(), SconfException);
+}
+
+SCONF_TEST(failedInterpolationLeavesDocumentUntouched) {
+    sConfTest::TempDir dir;
+    std::string base = dir.write("base.sconf", "[net]\nhost = example.org\n");
+    std::string cyclic = dir.write("cycle.sconf", "[a]\nx = ${a.y}\ny = ${a.x}\n");
+    std::string site = dir.write("site.sconf", "[site]\nurl = https://${net.host}\n");
+
+    sConfLoadOptions options;
+    options.interpolate = true;
+
+    sConfParser parser;
+    parser.load(base, options);
+
+    SCONF_CHECK_THROWS(parser.load(cyclic, options), SconfException);
+    SCONF_CHECK(!parser.hasSection("a"));
+
+    SCONF_CHECK_THROWS(parser.loadAll({site, cyclic}, options), SconfException);
+    SCONF_CHECK(!parser.hasSection("a"));
+    SCONF_CHECK(!parser.hasSection("site"));
+
+    parser.load(site, options);
+    SCONF_CHECK(parser.getOr("site", "url", "") == "https://example.org");
+}
+
+int main() {
+    return sConfTest::run();
+}
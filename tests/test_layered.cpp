@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+static sConfParser document(const std::string& section, const std::string& key, int value) {
+    sConfParser parser;
+    parser.addSection(section);
+    parser.setKey(section, key, sConfValue(value));
+
+    return parser;
+}
+
+SCONF_TEST(higherLayersWinKeyByKey) {
+    sConfParser defaults = document("server", "port", 80);
+    defaults.setKey("server", "workers", sConfValue(4));
+
+    sConfLayered stack;
+    stack.addLayer("defaults", defaults);
+    stack.addLayer("host", document("server", "port", 8080));
+
+    SCONF_CHECK(stack.getValue("server", "port").getInteger() == 8080);
+    SCONF_CHECK(stack.getWinningLayer("server", "port") == "host");
+    SCONF_CHECK(stack.getValue("server", "workers").getInteger() == 4);
+    SCONF_CHECK(stack.getWinningLayer("server", "workers") == "defaults");
+}
+
+SCONF_TEST(lookupsNormalizeNamesLikeLoad) {
+    sConfLayered stack;
+    stack.addLayer("defaults", document("server", "port", 80));
+
+    SCONF_CHECK(stack.hasKey("server", "port"));
+    SCONF_CHECK(stack.hasKey("  server ", "\tport"));
+    SCONF_CHECK(stack.hasKey("\"server\"", " \"port\" "));
+    SCONF_CHECK(stack.getValue(" \"server\" ", "port").getInteger() == 80);
+    SCONF_CHECK(!stack.hasKey("server", "por"));
+    SCONF_CHECK(!stack.hasKey("serve", "rport"));
+    SCONF_CHECK_THROWS(stack.getValue("server", "host"), SconfException);
+}
+
+SCONF_TEST(replacingAndRemovingLayersUpdatesWinners) {
+    sConfLayered stack;
+    stack.addLayer("defaults", document("server", "port", 80));
+    stack.addLayer("host", document("server", "port", 8080));
+
+    stack.setLayer("host", document("server", "host", 1));
+    SCONF_CHECK(stack.getWinningLayer("server", "port") == "defaults");
+    SCONF_CHECK(stack.getWinningLayer("server", "host") == "host");
+
+    stack.removeLayer("defaults");
+    SCONF_CHECK(!stack.hasKey("server", "port"));
+    SCONF_CHECK(stack.getValue("server", "host").getInteger() == 1);
+
+    stack.removeLayer("host");
+    SCONF_CHECK(stack.getSections().empty());
+}
+
+SCONF_TEST(flattenHoldsEffectiveValues) {
+    sConfLayered stack;
+    stack.addLayer("defaults", document("server", "port", 80));
+    stack.addLayer("host", document("client", "retries", 3));
+
+    sConfParser flat = stack.flatten();
+    SCONF_CHECK(flat.getOr("server", "port", 0) == 80);
+    SCONF_CHECK(flat.getOr("client", "retries", 0) == 3);
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include <string>
+#include <vector>
+#include "sconf_test.hpp"
+
+SCONF_TEST(laterFilesTakePrecedence) {
+    sConfTest::TempDir dir;
+    std::string base = dir.write("base.sconf", "[server]\nhost = base.example.org\nport = 80\n[base]\nonly = 1\n");
+    std::string site = dir.write("site.sconf", "[server]\nport = 8080\n[site]\nonly = 2\n");
+
+    sConfParser forward;
+    forward.loadAll({base, site});
+
+    SCONF_CHECK(forward.getOr("server", "port", 0) == 8080);
+    SCONF_CHECK(forward.getOr("server", "host", "") == "base.example.org");
+    SCONF_CHECK(forward.getOr("base", "only", 0) == 1);
+    SCONF_CHECK(forward.getOr("site", "only", 0) == 2);
+
+    sConfParser backward;
+    backward.loadAll({site, base});
+    SCONF_CHECK(backward.getOr("server", "port", 0) == 80);
+
+    sConfParser sequential;
+    sequential.load(base);
+    sequential.load(site);
+    SCONF_CHECK(sequential.getOr("server", "port", 0) == forward.getOr("server", "port", 0));
+}
+
+SCONF_TEST(loadDirectoryUsesNameOrder) {
+    sConfTest::TempDir dir;
+    const char* names[] = {"30-local.sconf", "05-early.sconf", "20-site.sconf", "10-base.sconf", "25-extra.sconf"};
+
+    for(const char* name : names)
+        dir.write(name, std::string("[order]\nwinner = ") + name + "\n[seen]\n" + std::string(name, 2) + " = true\n");
+    dir.write("99-notes.txt", "[order]\nwinner = notes\n");
+
+    for(int attempt = 0; attempt < 20; ++attempt) {
+        sConfParser parser;
+        parser.loadDirectory(dir.path(""), "*.sconf");
+
+        SCONF_CHECK(parser.getOr("order", "winner", "") == "30-local.sconf");
+        SCONF_CHECK(parser.getSection("seen").size() == 5);
+    }
+}
+
+SCONF_TEST(failingWorkerLeavesDocumentUntouched) {
+    sConfTest::TempDir dir;
+    std::vector<std::string> filenames;
+
+    for(int i = 0; i < 8; ++i)
+        filenames.push_back(dir.write("part" + std::to_string(i) + ".sconf",
+            "[part" + std::to_string(i) + "]\nvalue = " + std::to_string(i) + "\n"));
+    filenames[5] = dir.write("broken.sconf", "[part5]\nthis line has no separator\n");
+
+    sConfParser parser;
+    parser.addSection("kept");
+    parser.setKey("kept", "value", sConfValue(1));
+
+    SCONF_CHECK_THROWS(parser.loadAll(filenames), SconfException);
+    SCONF_CHECK(parser.getOr("kept", "value", 0) == 1);
+    SCONF_CHECK(!parser.hasSection("part0"));
+    SCONF_CHECK(!parser.hasSection("part7"));
+}
+
+SCONF_TEST(firstFailingFileInOrderIsReported) {
+    sConfTest::TempDir dir;
+    std::string good = dir.write("good.sconf", "[a]\nkey = 1\n");
+    std::string first = dir.path("missing-first.sconf");
+    std::string second = dir.path("missing-second.sconf");
+
+    for(int attempt = 0; attempt < 20; ++attempt) {
+        sConfParser parser;
+        std::string message;
+
+        try {
+            parser.loadAll({good, first, good, second});
+        }
+        catch(const SconfException& ex) {
+            message = ex.what();
+        }
+
+        SCONF_CHECK(message.find("missing-first.sconf") != std::string::npos);
+    }
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <sconf.hpp>
+#include <string>
+#include <string_view>
+#include "sconf_test.hpp"
+
+static sConfParser loadSample(sConfTest::TempDir& dir, const sConfLoadOptions& options = sConfLoadOptions()) {
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\nport = 8080\nsecure = true\nhuge = 1099511627776\nports = [80, 443]\n");
+
+    sConfParser parser;
+    parser.load(file, options);
+
+    return parser;
+}
+
+SCONF_TEST(missPathsAreNoexcept) {
+    const sConfParser parser;
+    const std::string section = "server", key = "port";
+
+    static_assert(noexcept(parser.find(section)), "find(section) must not throw");
+    static_assert(noexcept(parser.find(section, key)), "find(section, key) must not throw");
+    static_assert(noexcept(parser.tryGet<int>(section, key)), "tryGet must not throw");
+    static_assert(noexcept(parser.getOr(section, key, 0)), "getOr must not throw");
+    static_assert(noexcept(parser.getOr(section, key, "")), "getOr must not throw");
+    static_assert(noexcept(parser.tryGet<std::string_view>(section, key)), "string views must not throw");
+    static_assert(!noexcept(parser.tryGet<std::string>(section, key)), "string copies may throw");
+    static_assert(!noexcept(sConfValue().tryAs<std::vector<sConfValue>>()), "array copies may throw");
+
+    SCONF_CHECK(parser.find("server") == nullptr);
+}
+
+SCONF_TEST(stringFallbackIsNotCopied) {
+    sConfTest::TempDir dir;
+    const sConfParser parser = loadSample(dir);
+    const char* fallback = "fallback";
+
+    std::string_view host = parser.getOr("server", "host", fallback);
+    SCONF_CHECK(host == "example.org");
+    SCONF_CHECK(host.data() == parser.find("server", "host")->tryAs<std::string_view>()->data());
+
+    SCONF_CHECK(parser.getOr("server", "name", fallback).data() == fallback);
+    SCONF_CHECK(parser.getOr("server", "name", static_cast<const char*>(nullptr)).empty());
+}
+
+SCONF_TEST(untrimmedNamesAreNormalized) {
+    sConfTest::TempDir dir;
+    const sConfParser parser = loadSample(dir);
+
+    SCONF_CHECK(parser.find("  \"server\" ") != nullptr);
+    SCONF_CHECK(parser.getOr(" server", "\"port\"  ", 0) == 8080);
+    SCONF_CHECK(parser.tryGet<int>(" server ", " timeout ").error() == sConfError::KeyNotFound);
+    SCONF_CHECK(parser.tryGet<int>("\"client\"", "port").error() == sConfError::SectionNotFound);
+}
+
+SCONF_TEST(missingSection) {
+    sConfTest::TempDir dir;
+    const sConfParser parser = loadSample(dir);
+
+    SCONF_CHECK(parser.find("client") == nullptr);
+    SCONF_CHECK(parser.find("client", "port") == nullptr);
+    SCONF_CHECK(parser.tryGet<int>("client", "port").error() == sConfError::SectionNotFound);
+    SCONF_CHECK(!parser.tryGet<std::string>("client", "host"));
+    SCONF_CHECK(parser.getOr("client", "port", 42) == 42);
+    SCONF_CHECK(parser.getOr("client", "host", "fallback") == "fallback");
+}
+
+SCONF_TEST(missingKey) {
+    sConfTest::TempDir dir;
+    const sConfParser parser = loadSample(dir);
+
+    SCONF_CHECK(parser.find("server") != nullptr);
+    SCONF_CHECK(parser.find("server", "timeout") == nullptr);
+    SCONF_CHECK(parser.tryGet<int>("server", "timeout").error() == sConfError::KeyNotFound);
+    SCONF_CHECK(parser.getOr("server", "timeout", 30) == 30);
+    SCONF_CHECK(parser.getOr("server", "name", "fallback") == "fallback");
+}
+
+SCONF_TEST(wrongTypeFallsBackToDefault) {
+    sConfTest::TempDir dir;
+    sConfLoadOptions typed;
+    typed.inferTypes = true;
+
+    for(const sConfParser& parser : {loadSample(dir), loadSample(dir, typed)}) {
+        SCONF_CHECK(parser.tryGet<int>("server", "host").error() == sConfError::TypeMismatch);
+        SCONF_CHECK(parser.tryGet<int>("server", "huge").error() == sConfError::OutOfRange);
+        SCONF_CHECK(parser.tryGet<std::string>("server", "ports").error() == sConfError::TypeMismatch);
+        SCONF_CHECK(parser.tryGet<bool>("server", "port").error() == sConfError::TypeMismatch);
+
+        SCONF_CHECK(parser.getOr("server", "host", 7) == 7);
+        SCONF_CHECK(parser.getOr("server", "huge", 7) == 7);
+        SCONF_CHECK(parser.getOr("server", "ports", "fallback") == "fallback");
+        SCONF_CHECK(parser.getOr("server", "port", false) == false);
+
+        SCONF_CHECK(parser.getOr("server", "port", 0) == 8080);
+        SCONF_CHECK(parser.getOr("server", "huge", std::int64_t(0)) == 1099511627776);
+        SCONF_CHECK(parser.getOr("server", "secure", false) == true);
+    }
+}
+
+SCONF_TEST(unparsableLazySection) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[good]\nkey = 1\n[bad]\nthis line has no separator\n");
+
+    sConfLoadOptions options;
+    options.lazySections = true;
+
+    sConfParser parser;
+    parser.load(file, options);
+
+    const sConfParser& view = parser;
+    SCONF_CHECK(view.hasSection("bad"));
+    SCONF_CHECK(!view.hasSection("missing"));
+    SCONF_CHECK(view.getOr("good", "key", 0) == 1);
+    SCONF_CHECK(view.find("bad", "key") == nullptr);
+    SCONF_CHECK(view.tryGet<int>("bad", "key").error() == sConfError::InvalidSection);
+    SCONF_CHECK(view.getOr("bad", "key", 5) == 5);
+}
+
+int main() {
+    return sConfTest::run();
+}
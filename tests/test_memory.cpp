@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+static const sConfMemoryUsage::SectionUsage* findUsage(
+    const sConfMemoryUsage& usage,
+    const std::string& name
+) {
+    for(const auto& section : usage.sections)
+        if(section.name == name)
+            return &section;
+
+    return nullptr;
+}
+
+SCONF_TEST(eagerSectionsReportTheirKeys) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = a-rather-long-host-name.example.org\nports = [80, 443]\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    sConfMemoryUsage usage = parser.memoryUsage();
+    const auto* server = findUsage(usage, "server");
+
+    SCONF_CHECK(server && server->keys == 2);
+    SCONF_CHECK(server && server->valueBytes > 0 && server->arrayBytes > 0);
+    SCONF_CHECK(usage.pendingBytes == 0 && usage.sourceBytes == 0);
+    SCONF_CHECK(usage.total() >= server->total());
+}
+
+SCONF_TEST(unreadLazySectionsStayUnparsed) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\nport = 8080\n[client]\nretries = 3\n");
+
+    sConfLoadOptions options;
+    options.lazySections = true;
+
+    sConfParser parser;
+    parser.load(file, options);
+
+    sConfMemoryUsage before = parser.memoryUsage();
+    const auto* server = findUsage(before, "server");
+    SCONF_CHECK(server && server->keys == 0 && server->pendingBytes > 0);
+    SCONF_CHECK(before.pendingBytes > 0 && before.pendingBytes <= before.sourceBytes);
+
+    SCONF_CHECK(parser.hasSection("server") && parser.hasSection("client"));
+    sConfMemoryUsage again = parser.memoryUsage();
+    SCONF_CHECK(again.pendingBytes == before.pendingBytes);
+
+    SCONF_CHECK(parser.getOr("server", "port", 0) == 8080);
+
+    sConfMemoryUsage after = parser.memoryUsage();
+    server = findUsage(after, "server");
+    const auto* client = findUsage(after, "client");
+
+    SCONF_CHECK(server && server->keys == 2 && server->pendingBytes == 0);
+    SCONF_CHECK(client && client->keys == 0 && client->pendingBytes > 0);
+    SCONF_CHECK(after.pendingBytes == client->pendingBytes);
+}
+
+int main() {
+    return sConfTest::run();
+}
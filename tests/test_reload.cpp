@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+SCONF_TEST(unchangedReloadReusesEverySection) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\nport = 8080\n\n"
+        "[client]\nretries = 3\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    const sConfParser::Section* server = parser.find("server");
+    const sConfParser::Section* client = parser.find("client");
+
+    sConfDiff diff = parser.reload(file);
+    SCONF_CHECK(diff.isEmpty());
+    SCONF_CHECK(parser.find("server") == server);
+    SCONF_CHECK(parser.find("client") == client);
+}
+
+SCONF_TEST(reloadParsesOnlyChangedSections) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\n\n[client]\nretries = 3\n");
+
+    sConfParser parser;
+    parser.load(file);
+    const sConfParser::Section* server = parser.find("server");
+
+    dir.write("app.sconf", "[server]\nhost = example.org\n\n[client]\nretries = 5\n");
+    sConfDiff diff = parser.reload(file);
+
+    SCONF_CHECK(diff.getKeyChanges().size() == 1);
+    SCONF_CHECK(!diff.getKeyChanges().empty() && diff.getKeyChanges()[0].key == "retries");
+    SCONF_CHECK(parser.find("server") == server);
+    SCONF_CHECK(parser.getOr("client", "retries", 0) == 5);
+}
+
+SCONF_TEST(reloadReparsesSectionsModifiedInMemory) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[server]\nport = 8080\n");
+
+    sConfParser parser;
+    parser.load(file);
+    parser.setKey("server", "port", sConfValue(9090));
+
+    sConfDiff diff = parser.reload(file);
+    SCONF_CHECK(diff.getKeyChanges().size() == 1);
+    SCONF_CHECK(parser.getOr("server", "port", 0) == 8080);
+}
+
+SCONF_TEST(failedReloadLeavesDocumentUntouched) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[server]\nport = 8080\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    dir.write("app.sconf", "[server]\nport 8080\n");
+    SCONF_CHECK_THROWS(parser.reload(file), std::exception);
+    SCONF_CHECK(parser.getOr("server", "port", 0) == 8080);
+}
+
+SCONF_TEST(sectionsAfterAnEditAreReusedAndShifted) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\n\n[client]\nretries = 3\ntimeout = 5\n");
+
+    sConfParser parser;
+    parser.load(file);
+    const sConfParser::Section* client = parser.find("client");
+
+    dir.write("app.sconf",
+        "[server]\nhost = example.org\nport = 8080\n\n[client]\nretries = 3\ntimeout = 5\n");
+    sConfDiff diff = parser.reload(file);
+
+    SCONF_CHECK(diff.getKeyChanges().size() == 1);
+    SCONF_CHECK(parser.find("client") == client);
+
+    std::optional<sConfLocation> header = parser.locate("client");
+    std::optional<sConfLocation> timeout = parser.locate("client", "timeout");
+    SCONF_CHECK(header && header->line == 5);
+    SCONF_CHECK(timeout && timeout->line == 7 && timeout->column == 1);
+
+    dir.write("app.sconf",
+        "[client]\nretries = 3\ntimeout = 5\n[server]\nhost = example.org\nport = 8080\n");
+    SCONF_CHECK(parser.reload(file).isEmpty());
+    SCONF_CHECK(parser.find("client") == client);
+
+    timeout = parser.locate("client", "timeout");
+    std::optional<sConfLocation> port = parser.locate("server", "port");
+    SCONF_CHECK(timeout && timeout->line == 3);
+    SCONF_CHECK(port && port->line == 6);
+}
+
+SCONF_TEST(shiftingLeavesCopiesUntouched) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[a]\nx = 1\n[b]\ny = 2\n");
+
+    sConfParser parser;
+    parser.load(file);
+    sConfParser copy(parser);
+
+    dir.write("app.sconf", "; new comment line\n\n[b]\ny = 2\n[a]\nx = 1\n");
+    parser.reload(file);
+
+    std::optional<sConfLocation> moved = parser.locate("b", "y");
+    std::optional<sConfLocation> original = copy.locate("b", "y");
+    SCONF_CHECK(moved && moved->line == 4);
+    SCONF_CHECK(original && original->line == 4);
+    SCONF_CHECK(copy.locate("a", "x") && copy.locate("a", "x")->line == 2);
+    SCONF_CHECK(parser.locate("a", "x") && parser.locate("a", "x")->line == 6);
+}
+
+SCONF_TEST(changedSpacingWithinSectionIsReparsed) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[a]\nx = 1\ny = 2\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    dir.write("app.sconf", "[a]\nx = 1\n\ny = 2\n");
+    SCONF_CHECK(parser.reload(file).isEmpty());
+
+    std::optional<sConfLocation> y = parser.locate("a", "y");
+    SCONF_CHECK(y && y->line == 4);
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include <string>
+#include <vector>
+#include "sconf_test.hpp"
+
+static const char* const schemaText =
+    "[server]\n"
+    "port = integer required min=1 max=65535\n"
+    "host = string pattern=*.example.com length=1..253\n"
+    "ids  = array items=integer length=..3 min=0\n"
+    "name = string required\n"
+    "[client]\n"
+    "retries = integer required\n";
+
+static const sConfSchemaError* findError(
+    const std::vector<sConfSchemaError>& errors,
+    const std::string& key
+) {
+    for(const auto& error : errors)
+        if(error.key == key)
+            return &error;
+
+    return nullptr;
+}
+
+static bool mentions(const sConfSchemaError* error, const std::string& text) {
+    return error && error->message.find(text) != std::string::npos;
+}
+
+SCONF_TEST(validDocumentHasNoErrors) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nport = 8080\nhost = api.example.com\nids = [1, 2]\nname = api\n[client]\nretries = 3\n");
+
+    sConfSchema schema;
+    schema.load(dir.write("app.schema", schemaText));
+
+    sConfParser parser;
+    parser.load(file);
+
+    SCONF_CHECK(schema.validate(parser).empty());
+    SCONF_CHECK(schema.validateFile(file).empty());
+}
+
+SCONF_TEST(reportsTypeMismatchAtItsLine) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[server]\nname = api\nport = eighty\n[client]\nretries = 3\n");
+
+    sConfKeyRule rule;
+    rule.type = sConfValue::Type::Integer;
+
+    sConfSchema schema;
+    schema.addKey("server", "port", rule);
+
+    sConfParser parser;
+    parser.load(file);
+
+    std::vector<sConfSchemaError> errors = schema.validate(parser);
+    SCONF_CHECK(errors.size() == 1);
+    SCONF_CHECK(mentions(findError(errors, "port"), "Expected integer, found string"));
+    SCONF_CHECK(findError(errors, "port") && findError(errors, "port")->line == 3);
+}
+
+SCONF_TEST(reportsRangeLengthAndPattern) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nport = 70000\nhost = api.example.org\nname = api\n[client]\nretries = 3\n");
+
+    sConfSchema schema;
+    schema.load(dir.write("app.schema", schemaText));
+
+    sConfParser parser;
+    parser.load(file);
+
+    std::vector<sConfSchemaError> errors = schema.validate(parser);
+    SCONF_CHECK(errors.size() == 2);
+    SCONF_CHECK(mentions(findError(errors, "port"), "above the maximum of 65535"));
+    SCONF_CHECK(mentions(findError(errors, "host"), "does not match the pattern"));
+
+    sConfKeyRule rule;
+    rule.min = 1;
+    rule.minLength = 4;
+    rule.maxLength = 8;
+
+    sConfSchema lengths;
+    lengths.addKey("server", "port", rule);
+    lengths.addKey("server", "name", rule);
+    lengths.addKey("server", "host", rule);
+
+    errors = lengths.validate(parser);
+    SCONF_CHECK(errors.size() == 2);
+    SCONF_CHECK(mentions(findError(errors, "name"), "shorter than 4"));
+    SCONF_CHECK(mentions(findError(errors, "host"), "longer than 8"));
+}
+
+SCONF_TEST(checksArrayElements) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nport = 1\nname = api\nids = [1, two, 3]\n[client]\nretries = 3\n");
+    std::string longer = dir.write("longer.sconf",
+        "[server]\nport = 1\nname = api\nids = [1, -2, 3, 4]\n[client]\nretries = 3\n");
+
+    sConfSchema schema;
+    schema.load(dir.write("app.schema", schemaText));
+
+    std::vector<sConfSchemaError> errors = schema.validateFile(file);
+    SCONF_CHECK(errors.size() == 1);
+    SCONF_CHECK(mentions(findError(errors, "ids"), "Element 1: expected integer, found string"));
+    SCONF_CHECK(findError(errors, "ids") && findError(errors, "ids")->line == 4);
+
+    errors = schema.validateFile(longer);
+    SCONF_CHECK(errors.size() == 2);
+    SCONF_CHECK(mentions(findError(errors, "ids"), "Array has 4 elements, more than 3"));
+    SCONF_CHECK(errors.size() == 2 && mentions(&errors[1], "Element 1: Value -2 is below the minimum of 0"));
+}
+
+SCONF_TEST(reportsMissingRequiredKeys) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "\n[server]\nport = 8080\n");
+
+    sConfSchema schema;
+    schema.load(dir.write("app.schema", schemaText));
+
+    sConfParser parser;
+    parser.load(file);
+
+    for(const auto& errors : {schema.validate(parser), schema.validateFile(file)}) {
+        SCONF_CHECK(errors.size() == 2);
+
+        const sConfSchemaError* name = findError(errors, "name");
+        const sConfSchemaError* retries = findError(errors, "retries");
+
+        SCONF_CHECK(mentions(name, "Missing required key") && name->line == 2);
+        SCONF_CHECK(mentions(retries, "Missing required key") && retries->line == 0);
+    }
+}
+
+SCONF_TEST(rejectsInvalidSchemaFiles) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("bad.schema", "[server]\nport = integer\nhost = string colour=blue\n");
+
+    sConfSchema schema;
+    std::string message;
+
+    try {
+        schema.load(file);
+    }
+    catch(const SconfException& ex) {
+        message = ex.what();
+    }
+
+    SCONF_CHECK(message.find("colour=blue") != std::string::npos);
+    SCONF_CHECK(message.find("(line 3)") != std::string::npos);
+
+    sConfParser parser;
+    SCONF_CHECK(schema.validate(parser).empty());
+}
+
+int main() {
+    return sConfTest::run();
+}
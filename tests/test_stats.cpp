@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+SCONF_TEST(countersFollowTheBuild) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[a]\nkey = 1\n");
+
+    sConfParser parser;
+    parser.load(file);
+    parser.tryGet<int>("a", "key");
+    parser.tryGet<int>("a", "missing");
+
+    sConfStats stats = parser.stats();
+    sConfStats expected;
+#ifdef SCONF_ENABLE_STATS
+    expected.enabled = true;
+    expected.linesParsed = 2;
+    expected.lookups[sConfStats::TryGet] = 2;
+    expected.misses[sConfStats::TryGet] = 1;
+#endif
+
+    SCONF_CHECK(stats.enabled == expected.enabled);
+    SCONF_CHECK(stats.linesParsed == expected.linesParsed);
+    SCONF_CHECK(stats.lookups[sConfStats::TryGet] == expected.lookups[sConfStats::TryGet]);
+    SCONF_CHECK(stats.misses[sConfStats::TryGet] == expected.misses[sConfStats::TryGet]);
+}
+
+SCONF_TEST(copiesStartWithFreshCounters) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[a]\nkey = 1\n");
+
+    sConfParser parser;
+    parser.load(file);
+    sConfParser copy(parser);
+
+    SCONF_CHECK(copy.stats().linesParsed == 0);
+    SCONF_CHECK(copy.stats().enabled == parser.stats().enabled);
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include <utility>
+#include "sconf_test.hpp"
+
+/**
+ * @brief Gives a document one key and a subscriber counting its changes.
+ */
+static void watch(sConfParser& parser, int& calls) {
+    parser.addSection("server");
+    parser.setKey("server", "port", sConfValue(80));
+    parser.subscribe("server", "port", [&calls](const std::vector<sConfChange>&) {
+        ++calls;
+    });
+}
+
+SCONF_TEST(copyConstructorDropsSubscriptions) {
+    int calls = 0;
+    sConfParser original;
+    watch(original, calls);
+    sConfParser copy(original);
+
+    copy.setKey("server", "port", sConfValue(81));
+    SCONF_CHECK(calls == 0);
+
+    original.setKey("server", "port", sConfValue(82));
+    SCONF_CHECK(calls == 1);
+}
+
+SCONF_TEST(moveConstructorDropsSubscriptions) {
+    int calls = 0;
+    sConfParser original;
+    watch(original, calls);
+    sConfParser moved(std::move(original));
+
+    moved.setKey("server", "port", sConfValue(81));
+    SCONF_CHECK(calls == 0);
+}
+
+SCONF_TEST(copyAssignmentKeepsOwnSubscriptions) {
+    int sourceCalls = 0, targetCalls = 0;
+    sConfParser source;
+    watch(source, sourceCalls);
+    sConfParser target;
+    watch(target, targetCalls);
+
+    target = source;
+    target.setKey("server", "port", sConfValue(81));
+
+    SCONF_CHECK(sourceCalls == 0);
+    SCONF_CHECK(targetCalls == 1);
+}
+
+SCONF_TEST(moveAssignmentKeepsOwnSubscriptions) {
+    int sourceCalls = 0, targetCalls = 0;
+    sConfParser source;
+    watch(source, sourceCalls);
+    sConfParser target;
+    watch(target, targetCalls);
+
+    target = std::move(source);
+    target.setKey("server", "port", sConfValue(81));
+
+    SCONF_CHECK(sourceCalls == 0);
+    SCONF_CHECK(targetCalls == 1);
+}
+
+SCONF_TEST(unsubscribeStopsNotifications) {
+    int calls = 0;
+    sConfParser parser;
+    parser.addSection("server");
+    parser.setKey("server", "port", sConfValue(80));
+
+    sConfSubscriptions::Id id = parser.subscribe("server", [&calls](const std::vector<sConfChange>&) {
+        ++calls;
+    });
+
+    parser.setKey("server", "host", sConfValue(std::string("example.org")));
+    SCONF_CHECK(calls == 1);
+
+    SCONF_CHECK(parser.unsubscribe(id));
+    parser.setKey("server", "port", sConfValue(81));
+    SCONF_CHECK(calls == 1);
+    SCONF_CHECK(!parser.unsubscribe(id));
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+SCONF_TEST(everyMalformedLineIsReported) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\nport 8080\n@define x\n@include\ntimeout = 30\n");
+
+    sConfParser parser;
+    std::vector<sConfDiagnostic> diagnostics = parser.tryLoad(file);
+
+    SCONF_CHECK(diagnostics.size() == 3);
+    if(diagnostics.size() == 3) {
+        SCONF_CHECK(diagnostics[0].kind == sConfDiagnostic::Kind::InvalidKeyValue);
+        SCONF_CHECK(diagnostics[0].line == 3);
+        SCONF_CHECK(diagnostics[0].column == 1);
+        SCONF_CHECK(diagnostics[1].kind == sConfDiagnostic::Kind::UnknownDirective);
+        SCONF_CHECK(diagnostics[1].line == 4);
+        SCONF_CHECK(diagnostics[2].kind == sConfDiagnostic::Kind::MissingIncludePath);
+        SCONF_CHECK(diagnostics[2].line == 5);
+        SCONF_CHECK(diagnostics[0].file == file);
+    }
+}
+
+SCONF_TEST(validLinesAreLoaded) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nhost = example.org\nbroken\ntimeout = 30\n");
+
+    sConfParser parser;
+    parser.tryLoad(file);
+
+    SCONF_CHECK(parser.getOr("server", "host", "") == "example.org");
+    SCONF_CHECK(parser.getOr("server", "timeout", 0) == 30);
+}
+
+SCONF_TEST(readingStopsAtMaxErrors) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[a]\nbad1\nbad2\nbad3\nbad4\nkey = 1\n");
+
+    sConfLoadOptions options;
+    options.maxErrors = 2;
+
+    sConfParser parser;
+    std::vector<sConfDiagnostic> diagnostics = parser.tryLoad(file, options);
+
+    SCONF_CHECK(diagnostics.size() == 2);
+    SCONF_CHECK(!parser.hasSectionPairByKey("a", "key"));
+}
+
+SCONF_TEST(failedIncludeAndInterpolationAreReported) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "@include \"missing.sconf\"\n[a]\nx = ${a.nothing}\ny = 2\n");
+
+    sConfLoadOptions options;
+    options.interpolate = true;
+
+    sConfParser parser;
+    std::vector<sConfDiagnostic> diagnostics = parser.tryLoad(file, options);
+
+    bool includeFailed = false, interpolationFailed = false;
+    for(const auto& diagnostic : diagnostics) {
+        includeFailed |= diagnostic.kind == sConfDiagnostic::Kind::IncludeFailed;
+        interpolationFailed |= diagnostic.kind == sConfDiagnostic::Kind::InterpolationFailed;
+    }
+
+    SCONF_CHECK(includeFailed);
+    SCONF_CHECK(interpolationFailed);
+    SCONF_CHECK(parser.getOr("a", "y", 0) == 2);
+}
+
+SCONF_TEST(cleanFileHasNoDiagnostics) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "; comment\n[a]\nkey = [1, 2, 3]\n");
+
+    sConfParser parser;
+    SCONF_CHECK(parser.tryLoad(file).empty());
+    SCONF_CHECK(parser.isSectionPairArray("a", "key"));
+}
+
+SCONF_TEST(missingFileIsReported) {
+    sConfTest::TempDir dir;
+
+    sConfParser parser;
+    std::vector<sConfDiagnostic> diagnostics = parser.tryLoad(dir.path("missing.sconf"));
+
+    SCONF_CHECK(diagnostics.size() == 1);
+    SCONF_CHECK(!diagnostics.empty() && diagnostics[0].kind == sConfDiagnostic::Kind::OpenFailed);
+}
+
+int main() {
+    return sConfTest::run();
+}
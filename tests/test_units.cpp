@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+SCONF_TEST(unitSuffixesStayTextByDefault) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[cache]\nretention = 5d\nmode = 3m\nshard = 10k\nbuffer = 64MiB\ntimeout = 90s\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    for(const char* key : {"retention", "mode", "shard", "buffer", "timeout"})
+        SCONF_CHECK(parser.find("cache", key)->getType() == sConfValue::Type::String);
+
+    SCONF_CHECK(parser.getOr("cache", "retention", "") == "5d");
+    SCONF_CHECK(parser.getOr("cache", "mode", "") == "3m");
+    SCONF_CHECK(parser.getOr("cache", "shard", "") == "10k");
+
+    SCONF_CHECK(parser.find("cache", "retention")->getDuration() == std::chrono::hours(120));
+    SCONF_CHECK(parser.find("cache", "buffer")->getSize() == 64ull << 20);
+    SCONF_CHECK_THROWS(parser.find("cache", "shard")->getSize(), SconfException);
+
+    parser.save(dir.path("saved.sconf"));
+    sConfParser saved;
+    saved.load(dir.path("saved.sconf"));
+    SCONF_CHECK(saved.getOr("cache", "timeout", "") == "90s");
+}
+
+SCONF_TEST(inferTypesReadsDurationsAndSizes) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[cache]\ntimeout = 90s\nbuffer = 64MiB\nlabel = \"5d\"\nshard = 10k\n");
+
+    sConfLoadOptions options;
+    options.inferTypes = true;
+
+    sConfParser parser;
+    parser.load(file, options);
+
+    SCONF_CHECK(parser.find("cache", "timeout")->getType() == sConfValue::Type::Duration);
+    SCONF_CHECK(parser.find("cache", "buffer")->getType() == sConfValue::Type::Size);
+    SCONF_CHECK(parser.find("cache", "label")->getType() == sConfValue::Type::String);
+    SCONF_CHECK(parser.find("cache", "shard")->getType() == sConfValue::Type::String);
+    SCONF_CHECK(parser.getOr("cache", "timeout", std::chrono::nanoseconds(0)) == std::chrono::seconds(90));
+
+    parser.save(dir.path("saved.sconf"));
+    sConfParser saved;
+    saved.load(dir.path("saved.sconf"));
+    SCONF_CHECK(saved.getOr("cache", "timeout", "") == "1m30s");
+    SCONF_CHECK(saved.getOr("cache", "label", "") == "5d");
+}
+
+SCONF_TEST(schemaAsksForDurationsOnText) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[cache]\ntimeout = 250ms\nretries = soon\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    sConfKeyRule rule;
+    rule.type = sConfValue::Type::Duration;
+
+    sConfSchema schema;
+    schema.addKey("cache", "timeout", rule);
+    schema.addKey("cache", "retries", rule);
+
+    std::vector<sConfSchemaError> errors = schema.validate(parser);
+    SCONF_CHECK(errors.size() == 1);
+    SCONF_CHECK(!errors.empty() && errors[0].key == "retries");
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <sconf.hpp>
+#include "sconf_test.hpp"
+
+SCONF_TEST(decimalIntegersUse64Bits) {
+    SCONF_CHECK(sConfValue::fromRaw("42").getInteger64() == 42);
+    SCONF_CHECK(sConfValue::fromRaw("-42").getInteger64() == -42);
+    SCONF_CHECK(sConfValue::fromRaw("9223372036854775807").getInteger64() ==
+        std::numeric_limits<std::int64_t>::max());
+    SCONF_CHECK(sConfValue::fromRaw("-9223372036854775808").getInteger64() ==
+        std::numeric_limits<std::int64_t>::min());
+    SCONF_CHECK(sConfValue::fromRaw("1_000_000").getInteger64() == 1000000);
+}
+
+SCONF_TEST(prefixedLiterals) {
+    SCONF_CHECK(sConfValue::fromRaw("0xff").getInteger64() == 255);
+    SCONF_CHECK(sConfValue::fromRaw("0XFF").getInteger64() == 255);
+    SCONF_CHECK(sConfValue::fromRaw("-0x10").getInteger64() == -16);
+    SCONF_CHECK(sConfValue::fromRaw("0o755").getInteger64() == 0755);
+    SCONF_CHECK(sConfValue::fromRaw("0b1010").getInteger64() == 10);
+    SCONF_CHECK(sConfValue::fromRaw("0xdead_beef").getInteger64() == 0xdeadbeef);
+
+    for(const char* text : {"0x10", "0o17", "0b11"})
+        SCONF_CHECK(sConfValue::fromRaw(text).getType() == sConfValue::Type::Integer);
+}
+
+SCONF_TEST(unsignedRangeAboveInt64) {
+    sConfValue max = sConfValue::fromRaw("18446744073709551615");
+    SCONF_CHECK(max.getType() == sConfValue::Type::Integer);
+    SCONF_CHECK(max.getUnsigned() == std::numeric_limits<std::uint64_t>::max());
+    SCONF_CHECK_THROWS(max.getInteger64(), SconfException);
+
+    sConfValue hex = sConfValue::fromRaw("0xffffffffffffffff");
+    SCONF_CHECK(hex.getUnsigned() == std::numeric_limits<std::uint64_t>::max());
+    SCONF_CHECK(max.tryAs<std::int64_t>().error() == sConfError::OutOfRange);
+}
+
+SCONF_TEST(narrowAccessorsCheckRange) {
+    sConfValue big = sConfValue::fromRaw("4294967296");
+    SCONF_CHECK_THROWS(big.getInteger(), SconfException);
+    SCONF_CHECK(big.tryAs<int>().error() == sConfError::OutOfRange);
+    SCONF_CHECK(sConfValue::fromRaw("-1").tryAs<std::uint64_t>().error() == sConfError::OutOfRange);
+}
+
+SCONF_TEST(overflowingLiteralsStayIntegers) {
+    const char* literals[] = {
+        "18446744073709551616",
+        "-9223372036854775809",
+        "0x1FFFFFFFFFFFFFFFF",
+        "0b1_0000000000000000000000000000000000000000000000000000000000000000",
+        "123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890"
+    };
+
+    for(const char* text : literals) {
+        sConfValue value = sConfValue::fromRaw(text);
+        SCONF_CHECK(value.getType() == sConfValue::Type::Integer);
+        SCONF_CHECK(value.toString() == text);
+        SCONF_CHECK(value.tryAs<std::int64_t>().error() == sConfError::OutOfRange);
+        SCONF_CHECK(value.tryAs<std::uint64_t>().error() == sConfError::OutOfRange);
+        SCONF_CHECK(value.tryAs<double>().error() == sConfError::OutOfRange);
+        SCONF_CHECK_THROWS(value.getUnsigned(), SconfException);
+        SCONF_CHECK_THROWS(value.getDouble(), SconfException);
+    }
+
+    SCONF_CHECK(sConfValue::fromRaw("0x0000000000000000000000001").getInteger64() == 1);
+    SCONF_CHECK(sConfValue::fromRaw("1e400").getType() != sConfValue::Type::Integer);
+}
+
+SCONF_TEST(malformedLiteralsAreNotIntegers) {
+    for(const char* text : {"0x", "0b102", "1__0", "_1", "1_", "0o8", "12abc"})
+        SCONF_CHECK(sConfValue::fromRaw(text).getType() != sConfValue::Type::Integer);
+
+    SCONF_CHECK(sConfValue::fromRaw("1.5").getType() == sConfValue::Type::Double);
+}
+
+SCONF_TEST(integersRoundTripThroughSave) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[a]\nmask = 0xff\nbig = 18446744073709551615\nneg = -5\n");
+
+    sConfParser parser;
+    parser.load(file);
+    parser.save(dir.path("saved.sconf"));
+
+    sConfParser saved;
+    saved.load(dir.path("saved.sconf"));
+    SCONF_CHECK(saved.getOr<std::int64_t>("a", "mask", 0) == 255);
+    SCONF_CHECK(saved.getOr<std::uint64_t>("a", "big", 0) == std::numeric_limits<std::uint64_t>::max());
+    SCONF_CHECK(saved.getOr<std::int64_t>("a", "neg", 0) == -5);
+}
+
+SCONF_TEST(getStringIsStrictAndToStringIsLenient) {
+    sConfValue port = sConfValue::fromRaw("8080");
+    SCONF_CHECK_THROWS(port.getString(), SconfException);
+    SCONF_CHECK(port.tryAs<std::string>().error() == sConfError::TypeMismatch);
+    SCONF_CHECK(port.toString() == "8080");
+
+    SCONF_CHECK(sConfValue::fromRaw("\"8080\"").getString() == "8080");
+    SCONF_CHECK(sConfValue::fromRaw("true").toString() == "true");
+    SCONF_CHECK(sConfValue::fromRaw("64MiB").toString() == "64MiB");
+    SCONF_CHECK(sConfValue(std::vector<sConfValue>{sConfValue(1), sConfValue(std::string("a"))}).toString() == "[1, a]");
+}
+
+SCONF_TEST(loadedScalarsAreStringsByDefault) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf",
+        "[server]\nport = 8080\nname = 5d\nquoted = \"42\"\nlist = [1, two]\n");
+
+    sConfParser parser;
+    parser.load(file);
+
+    const sConfValue& port = *parser.find("server", "port");
+    SCONF_CHECK(port.getType() == sConfValue::Type::String);
+    SCONF_CHECK(port.getInferredType() == sConfValue::Type::Integer);
+    SCONF_CHECK(port.getString() == "8080");
+    SCONF_CHECK(port.getInteger() == 8080);
+    SCONF_CHECK(parser.getOr("server", "port", 0) == 8080);
+
+    SCONF_CHECK(parser.find("server", "name")->getString() == "5d");
+    SCONF_CHECK(parser.getOr("server", "name", "") == "5d");
+
+    const sConfValue& quoted = *parser.find("server", "quoted");
+    SCONF_CHECK(quoted.getString() == "42");
+    SCONF_CHECK(quoted.tryAs<int>().error() == sConfError::TypeMismatch);
+
+    const sConfValue& list = *parser.find("server", "list");
+    SCONF_CHECK(list.getType() == sConfValue::Type::Array);
+    SCONF_CHECK(list.getElement(0).getString() == "1");
+    SCONF_CHECK(list.getElement(0).getInteger() == 1);
+    SCONF_CHECK(list.getElement(1).getString() == "two");
+}
+
+SCONF_TEST(inferTypesGivesLoadedValuesTheirType) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[server]\nport = 8080\nquoted = \"42\"\n");
+
+    sConfLoadOptions options;
+    options.inferTypes = true;
+
+    sConfParser parser;
+    parser.load(file, options);
+
+    const sConfValue& port = *parser.find("server", "port");
+    SCONF_CHECK(port.getType() == sConfValue::Type::Integer);
+    SCONF_CHECK_THROWS(port.getString(), SconfException);
+    SCONF_CHECK(port.getInteger() == 8080);
+    SCONF_CHECK(parser.find("server", "quoted")->getType() == sConfValue::Type::String);
+
+    options.lazyValues = true;
+    sConfParser lazy;
+    lazy.load(file, options);
+    SCONF_CHECK(lazy.find("server", "port")->getType() == sConfValue::Type::Integer);
+}
+
+SCONF_TEST(textKeepsItsFormThroughSave) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[a]\nport = 8080\nquoted = \"8080\"\nname = plain\n");
+
+    sConfParser parser;
+    parser.load(file);
+    parser.save(dir.path("saved.sconf"));
+
+    sConfParser saved;
+    saved.load(dir.path("saved.sconf"));
+    SCONF_CHECK(*saved.find("a", "port") == *parser.find("a", "port"));
+    SCONF_CHECK(saved.getOr("a", "port", 0) == 8080);
+    SCONF_CHECK(saved.find("a", "quoted")->tryAs<int>().error() == sConfError::TypeMismatch);
+    SCONF_CHECK(saved.getOr("a", "name", "") == "plain");
+}
+
+SCONF_TEST(stringFieldsBindAnyScalar) {
+    sConfParser parser;
+    parser.addSection("release");
+    parser.setKey("release", "version", sConfValue::fromRaw("1.2"));
+    parser.setKey("release", "name", sConfValue(std::string("stable")));
+
+    std::string version, name;
+    SCONF_CHECK(sConfFieldTraits<std::string>::read(*parser.find("release", "version"), version));
+    SCONF_CHECK(sConfFieldTraits<std::string>::read(*parser.find("release", "name"), name));
+    SCONF_CHECK(version == "1.2" && name == "stable");
+}
+
+int main() {
+    return sConfTest::run();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 - Nathanne Isip
+ * This file is part of sConf.
+ * 
+ * N8 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ * 
+ * N8 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with N8. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <sconf.hpp>
+#include <string>
+#include <thread>
+#include "sconf_test.hpp"
+
+static const std::chrono::seconds patience(10);
+
+static void replace(const sConfTest::TempDir& dir, const std::string& name, const std::string& content) {
+    std::string staged = dir.write(name + ".tmp", content);
+    std::filesystem::rename(staged, dir.path(name));
+}
+
+SCONF_TEST(writingTheFileReloadsIt) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[app]\nlevel = 1\n");
+
+    sConfConcurrent document;
+    sConfWatcher watcher(document, {file}, std::chrono::milliseconds(20));
+
+    std::atomic<int> reloads{0};
+    watcher.onReload([&](const sConfConcurrent::Snapshot&) {
+        reloads.fetch_add(1);
+    });
+
+    std::future<sConfConcurrent::Snapshot> initial = watcher.nextReload();
+    watcher.start();
+
+    SCONF_CHECK(initial.wait_for(patience) == std::future_status::ready);
+    SCONF_CHECK(document.snapshot()->getOr("app", "level", 0) == 1);
+
+    std::future<sConfConcurrent::Snapshot> next = watcher.nextReload();
+    dir.write("app.sconf", "[app]\nlevel = 2\n");
+
+    SCONF_CHECK(next.wait_for(patience) == std::future_status::ready);
+    SCONF_CHECK(next.get()->getOr("app", "level", 0) == 2);
+    SCONF_CHECK(document.snapshot()->getOr("app", "level", 0) == 2);
+
+    watcher.stop();
+    SCONF_CHECK(reloads.load() >= 2);
+    SCONF_CHECK(!watcher.isRunning());
+}
+
+SCONF_TEST(continuousWritesReloadAfterMaxDelay) {
+    sConfTest::TempDir dir;
+    std::string file = dir.write("app.sconf", "[app]\nlevel = 0\n");
+
+    sConfConcurrent document;
+    sConfWatcher watcher(document, {file}, std::chrono::milliseconds(500), std::chrono::milliseconds(200));
+
+    std::future<sConfConcurrent::Snapshot> initial = watcher.nextReload();
+    watcher.start();
+    SCONF_CHECK(initial.wait_for(patience) == std::future_status::ready);
+
+    std::future<sConfConcurrent::Snapshot> next = watcher.nextReload();
+    std::atomic<bool> writing{true};
+    std::thread writer([&]() {
+        for(int level = 1; writing.load(); ++level) {
+            replace(dir, "app.sconf", "[app]\nlevel = " + std::to_string(level) + "\n");
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    });
+
+    // The writes never leave the 500ms quiet period the debounce asks for,
+    // so only the 200ms cap can trigger this reload.
+    bool reloaded = next.wait_for(patience) == std::future_status::ready;
+    writing.store(false);
+    writer.join();
+
+    SCONF_CHECK(reloaded);
+    SCONF_CHECK(reloaded && next.get()->getOr("app", "level", 0) > 0);
+
+    watcher.stop();
+}
+
+int main() {
+    return sConfTest::run();
+}